@@ -0,0 +1,129 @@
+// Sıcak yolun yığın ayırmadığını doğrular: malloc/calloc/realloc/free bağlayıcıda
+// sayaçlı sürümlerle sarılır, ardından varsayılan tahtada ve bir seviye düzeninde
+// tohumlu oyunlar EngineStep (arenayla, olay halkasına yazarak) ve EngineGenerateMoves
+// ile oynanır. Sayaçlar sıfırdan farklıysa ya da arena taşarsa 1 ile çıkar.
+//
+// Derleme (Linux): cc -O2 -std=c11 alloctest.c engine.c arena.c eventbus.c -o alloctest -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+// Kullanım: ./alloctest [--games 2000] [--moves 200] [--level levels/jelly.txt]
+
+#include "engine.h"
+#include "eventbus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_BYTES (64 * 1024)
+#define MAX_LEVEL_TEXT 4096
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *p, size_t size);
+void __real_free(void *p);
+
+static long long mallocCalls, callocCalls, reallocCalls, freeCalls;
+
+void *__wrap_malloc(size_t size)
+{
+    mallocCalls++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    callocCalls++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *p, size_t size)
+{
+    reallocCalls++;
+    return __real_realloc(p, size);
+}
+
+void __wrap_free(void *p)
+{
+    freeCalls++;
+    __real_free(p);
+}
+
+static Engine engine;
+static EventBus bus;
+static Arena arena;
+static _Alignas(16) unsigned char arenaMemory[ARENA_BYTES];
+
+// Oyun bitene, hamle kalmayana ya da moveCount dolana kadar oyna; adım sayısını döndürür
+static long long PlayGames(const char *layout, int games, int moveCount)
+{
+    long long steps = 0;
+    for (int g = 0; g < games; g++)
+    {
+        EngineInit(&engine, (uint64_t)g + 1);
+        if (layout != NULL)
+        {
+            EngineLoadLevel(&engine, layout);
+            EngineFillNoMatches(&engine);
+        }
+        engine.events = &bus;
+
+        uint64_t pick = (uint64_t)g * 0x9E3779B97F4A7C15ull + 1;
+        for (int i = 0; i < moveCount && engine.levelState == LEVEL_PLAYING; i++)
+        {
+            MoveList moves;
+            if (EngineGenerateMoves(&engine, &moves) == 0)
+                break;
+            pick ^= pick << 13;
+            pick ^= pick >> 7;
+            pick ^= pick << 17;
+            ArenaReset(&arena);
+            StepResult result;
+            if (EngineStep(&engine, moves.moves[pick % (uint64_t)moves.count], &arena, &result) >= 0)
+                steps++;
+        }
+    }
+    return steps;
+}
+
+int main(int argc, char **argv)
+{
+    int games = 2000, moveCount = 200;
+    const char *levelPath = "levels/jelly.txt";
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (strcmp(argv[i], "--games") == 0)
+            games = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--moves") == 0)
+            moveCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--level") == 0)
+            levelPath = argv[i + 1];
+    }
+
+    // Dosya okuma ve kurulum sayımın dışında
+    static char level[MAX_LEVEL_TEXT];
+    FILE *file = fopen(levelPath, "r");
+    size_t length = file != NULL ? fread(level, 1, sizeof(level) - 1, file) : 0;
+    if (file != NULL)
+        fclose(file);
+    level[length] = '\0';
+    if (length == 0 || !EngineLoadLevel(&engine, level))
+    {
+        fprintf(stderr, "%s okunamadı ya da geçerli bir düzen değil\n", levelPath);
+        return 1;
+    }
+    EventBusInit(&bus);
+    ArenaInit(&arena, arenaMemory, sizeof(arenaMemory));
+
+    mallocCalls = callocCalls = reallocCalls = freeCalls = 0;
+    long long steps = PlayGames(NULL, games, moveCount);
+    steps += PlayGames(level, games, moveCount);
+    long long allocations = mallocCalls + callocCalls + reallocCalls + freeCalls;
+
+    printf("%lld adım, malloc %lld, calloc %lld, realloc %lld, free %lld, arena tepe %zu B, taşma %zu\n",
+        steps, mallocCalls, callocCalls, reallocCalls, freeCalls, arena.peak, arena.overflows);
+    if (allocations != 0 || arena.overflows != 0 || steps == 0)
+    {
+        fprintf(stderr, "BAŞARISIZ: sıcak yol yığına dokundu ya da arena taştı\n");
+        return 1;
+    }
+    printf("tamam\n");
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include "arena.h"
+
+void ArenaInit(Arena *a, void *memory, size_t capacity)
+{
+    a->base = memory;
+    a->capacity = memory != NULL ? capacity : 0;
+    a->used = 0;
+    a->peak = 0;
+    a->overflows = 0;
+}
+
+void *ArenaAlloc(Arena *a, size_t size)
+{
+    size_t start = (a->used + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    if (start > a->capacity || size > a->capacity - start)
+    {
+        a->overflows++;
+        return NULL;
+    }
+    a->used = start + size;
+    if (a->used > a->peak)
+        a->peak = a->used;
+    return a->base + start;
+}
+
+void ArenaReset(Arena *a)
+{
+    a->used = 0;
+}
+
+size_t ArenaMark(const Arena *a)
+{
+    return a->used;
+}
+
+void ArenaRewind(Arena *a, size_t mark)
+{
+    if (mark <= a->used)
+        a->used = mark;
+}
@@ -0,0 +1,30 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+// Hamle/arama başına sıfırlanan basit bölge (bump) ayırıcı.
+// Bellek çağıran tarafından bir kez verilir (16 bayta hizalı); dolarsa malloc'a
+// düşmez, NULL döner ve overflows sayacını artırır.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ARENA_ALIGNMENT 16
+
+typedef struct
+{
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+    size_t peak;      // Ayar için en yüksek kullanım
+    size_t overflows; // Sığmayan istek sayısı; sıcak yolda 0 kalmalı
+} Arena;
+
+void ArenaInit(Arena *a, void *memory, size_t capacity);
+void *ArenaAlloc(Arena *a, size_t size);
+void ArenaReset(Arena *a);
+
+// İç içe arama için: işareti al, alt ağaç bitince geri sar
+size_t ArenaMark(const Arena *a);
+void ArenaRewind(Arena *a, size_t mark);
+
+#endif
@@ -0,0 +1,471 @@
+#include "batchenv.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CELLS (ROWS * COLS)
+#define CELL(r, c) ((r) * COLS + (c))
+#define LANE_ALIGN 64 // Şerit sayısı bu kadara yuvarlanır, satırlar önbellek hattına hizalı
+#define OUTSIDE_CELL -2 // Tahta dışı: hiçbir şekerle eşit değil
+
+// Tahta durumu tahtalar arası yapı-dizisi (SoA) düzeninde tutulur:
+// cells[hücre * stride + tahta]. Böylece eşleşme, düşürme ve doldurma çekirdekleri
+// aynı hücreyi tüm tahtalar için tek bir düz döngüde işler ve derleyici SIMD'ye çevirir.
+struct BatchEnv
+{
+    int count;
+    int stride;
+    int maxMoves;
+    int8_t *cells;
+    uint8_t *marked;
+    uint32_t *rng;
+    uint8_t *found;     // Bu kaskad adımında yeni eşleşme bulundu
+    uint8_t *destroyed; // Bu kaskad adımında patlayan şeker sayısı
+    uint8_t *hasMove;
+    int32_t *combo;
+    int32_t *moves;
+    int32_t *gained;
+    int8_t *outside;    // OUTSIDE_CELL ile dolu sahte satır
+    int8_t *observations;
+    float *rewards;
+    uint8_t *dones;
+};
+
+static void *AlignedCalloc(size_t size)
+{
+    size = (size + LANE_ALIGN - 1) / LANE_ALIGN * LANE_ALIGN;
+#ifdef _MSC_VER
+    void *p = _aligned_malloc(size, LANE_ALIGN);
+#else
+    void *p = aligned_alloc(LANE_ALIGN, size);
+#endif
+    if (p != NULL)
+        memset(p, 0, size);
+    return p;
+}
+
+static void AlignedFree(void *p)
+{
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+static inline uint32_t NextLaneRandom(uint32_t x)
+{
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// Tahta dışındaki hücreler için sahte satır döner, çekirdekler dallanmadan okur
+static inline const int8_t *Lanes(const BatchEnv *env, int r, int c)
+{
+    if (r < 0 || r >= ROWS || c < 0 || c >= COLS)
+        return env->outside;
+    return env->cells + (size_t)CELL(r, c) * (size_t)env->stride;
+}
+
+static inline int8_t LaneCell(const BatchEnv *env, int b, int r, int c)
+{
+    return env->cells[(size_t)CELL(r, c) * (size_t)env->stride + (size_t)b];
+}
+
+static inline void SetLaneCell(BatchEnv *env, int b, int r, int c, int8_t type)
+{
+    env->cells[(size_t)CELL(r, c) * (size_t)env->stride + (size_t)b] = type;
+}
+
+// Tek tahtayı motorun kurallarıyla eşleşmesiz ve oynanabilir şekilde dağıt (nadir yol)
+static void FillLane(BatchEnv *env, int b)
+{
+    uint32_t hi = env->rng[b] = NextLaneRandom(env->rng[b]);
+    uint32_t lo = env->rng[b] = NextLaneRandom(env->rng[b]);
+    Engine e;
+    EngineInit(&e, ((uint64_t)hi << 32) | lo);
+    for (int r = 0; r < ROWS; r++)
+        for (int c = 0; c < COLS; c++)
+            SetLaneCell(env, b, r, c, e.type[r][c]);
+}
+
+static bool LaneMatchesAt(const BatchEnv *env, int b, int r, int c)
+{
+    int8_t type = LaneCell(env, b, r, c);
+    int left = c, right = c;
+    while (left > 0 && LaneCell(env, b, r, left - 1) == type)
+        left--;
+    while (right < COLS - 1 && LaneCell(env, b, r, right + 1) == type)
+        right++;
+    if (right - left >= 2)
+        return true;
+    int top = r, bottom = r;
+    while (top > 0 && LaneCell(env, b, top - 1, c) == type)
+        top--;
+    while (bottom < ROWS - 1 && LaneCell(env, b, bottom + 1, c) == type)
+        bottom++;
+    return bottom - top >= 2;
+}
+
+// Eylemi doğrula, geçerliyse değişimi yap (EngineIsValidSwap ile aynı kural)
+static bool LaneTrySwap(BatchEnv *env, int b, int32_t action)
+{
+    if (action < 0 || action >= BATCH_ACTIONS)
+        return false;
+    int r0 = (action / 2) / COLS, c0 = (action / 2) % COLS;
+    int r1 = r0 + (action & 1), c1 = c0 + !(action & 1);
+    if (r1 >= ROWS || c1 >= COLS)
+        return false;
+    int8_t a = LaneCell(env, b, r0, c0);
+    int8_t t = LaneCell(env, b, r1, c1);
+    if (a == t)
+        return false;
+    SetLaneCell(env, b, r0, c0, t);
+    SetLaneCell(env, b, r1, c1, a);
+    if (LaneMatchesAt(env, b, r0, c0) || LaneMatchesAt(env, b, r1, c1))
+        return true;
+    SetLaneCell(env, b, r0, c0, a);
+    SetLaneCell(env, b, r1, c1, t);
+    return false;
+}
+
+// Tek bir üçlü pencere, tüm şeritler için. restrict parametreler derleyicinin
+// takma ad denetimi olmadan vektörleştirmesi için ayrı fonksiyonda.
+static void MarkWindow(int n, const int8_t *restrict a, const int8_t *restrict b, const int8_t *restrict d,
+    uint8_t *restrict ma, uint8_t *restrict mb, uint8_t *restrict md, uint8_t *restrict found)
+{
+    for (int i = 0; i < n; i++)
+    {
+        uint8_t run = (uint8_t)((a[i] == b[i]) & (b[i] == d[i]) & (a[i] >= 0));
+        ma[i] |= run;
+        mb[i] |= run;
+        md[i] |= run;
+        found[i] |= run;
+    }
+}
+
+// Üçlü pencerelerle eşleşmeleri işaretle; önceki işaretler korunur (motorla aynı)
+static bool MarkKernel(BatchEnv *env)
+{
+    const int n = env->stride;
+    memset(env->found, 0, (size_t)n);
+    for (int r = 0; r < ROWS; r++)
+    {
+        for (int c = 0; c < COLS; c++)
+        {
+            for (int dir = 0; dir < 2; dir++)
+            {
+                int dr = dir, dc = !dir;
+                if (r + 2 * dr >= ROWS || c + 2 * dc >= COLS)
+                    continue;
+                size_t step = (size_t)(dr * COLS + dc) * (size_t)n;
+                size_t base = (size_t)CELL(r, c) * (size_t)n;
+                int8_t *t = env->cells + base;
+                uint8_t *m = env->marked + base;
+                MarkWindow(n, t, t + step, t + 2 * step, m, m + step, m + 2 * step, env->found);
+            }
+        }
+    }
+    uint8_t any = 0;
+    for (int i = 0; i < n; i++)
+        any |= env->found[i];
+    return any != 0;
+}
+
+// Eşleşme bulunan tahtalarda işaretlileri patlat ve puanla; bulunmayanlarda kaskad biter
+static void DestroyKernel(BatchEnv *env)
+{
+    const int n = env->stride;
+    const uint8_t *restrict found = env->found;
+    uint8_t *restrict destroyed = env->destroyed;
+    memset(destroyed, 0, (size_t)n);
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        int8_t *restrict t = env->cells + (size_t)cell * (size_t)n;
+        uint8_t *restrict m = env->marked + (size_t)cell * (size_t)n;
+        for (int i = 0; i < n; i++)
+        {
+            uint8_t kill = m[i] & found[i];
+            destroyed[i] += kill;
+            t[i] = kill ? (int8_t)EMPTY_CELL : t[i];
+            m[i] &= found[i];
+        }
+    }
+    int32_t *restrict combo = env->combo;
+    int32_t *restrict gained = env->gained;
+    for (int i = 0; i < n; i++)
+    {
+        int d = destroyed[i];
+        int points = d >= 5 ? 200 : (d == 4 ? 100 : (d == 3 ? 60 : 0));
+        gained[i] += points * combo[i];
+        combo[i] += found[i];
+    }
+}
+
+// Boşlukları yukarı kabarcıkla: her geçiş boşluğun üstündekileri bir hücre indirir.
+// Sonra işaretler sadece boş kalan hücrelerde korunur (motordaki kopyalama ile aynı sonuç).
+static void GravityKernel(BatchEnv *env)
+{
+    const int n = env->stride;
+    for (int c = 0; c < COLS; c++)
+    {
+        for (int pass = 0; pass < ROWS - 1; pass++)
+        {
+            for (int r = ROWS - 1; r > 0; r--)
+            {
+                int8_t *restrict lo = env->cells + (size_t)CELL(r, c) * (size_t)n;
+                int8_t *restrict hi = env->cells + (size_t)CELL(r - 1, c) * (size_t)n;
+                for (int i = 0; i < n; i++)
+                {
+                    int8_t l = lo[i], h = hi[i];
+                    bool fall = l == EMPTY_CELL;
+                    lo[i] = fall ? h : l;
+                    hi[i] = fall ? (int8_t)EMPTY_CELL : h;
+                }
+            }
+        }
+    }
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        const int8_t *restrict t = env->cells + (size_t)cell * (size_t)n;
+        uint8_t *restrict m = env->marked + (size_t)cell * (size_t)n;
+        for (int i = 0; i < n; i++)
+            m[i] &= (uint8_t)(t[i] == EMPTY_CELL);
+    }
+}
+
+// Sayı sadece boş hücrede çekilir (dalsız seçimle): tahtanın doldurma dizisi
+// aynı toplu ortamdaki diğer tahtaların kaç kaskad adımı sürdüğüne bağlı olmasın
+static void RefillKernel(BatchEnv *env)
+{
+    const int n = env->stride;
+    uint32_t *restrict rng = env->rng;
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        int8_t *restrict t = env->cells + (size_t)cell * (size_t)n;
+        for (int i = 0; i < n; i++)
+        {
+            uint32_t x = NextLaneRandom(rng[i]);
+            bool empty = t[i] == EMPTY_CELL;
+            int8_t candy = (int8_t)(((x >> 16) * CANDY_TYPES) >> 16);
+            rng[i] = empty ? x : rng[i];
+            t[i] = empty ? candy : t[i];
+        }
+    }
+}
+
+// Bir üçlü pencere x y z için: iki hücre aynıysa üçüncünün komşularından biri aynı tür mü
+static void MoveWindow(int n, const int8_t *restrict x, const int8_t *restrict y, const int8_t *restrict z,
+    const int8_t *const nz[3], const int8_t *const nx[3], const int8_t *const ny[2], uint8_t *restrict hasMove)
+{
+    const int8_t *restrict z1 = nz[0], *restrict z2 = nz[1], *restrict z3 = nz[2];
+    const int8_t *restrict x1 = nx[0], *restrict x2 = nx[1], *restrict x3 = nx[2];
+    const int8_t *restrict y1 = ny[0], *restrict y2 = ny[1];
+    for (int i = 0; i < n; i++)
+    {
+        int8_t a = x[i], b = y[i], c = z[i];
+        uint8_t m = (uint8_t)(((a == b) & ((z1[i] == a) | (z2[i] == a) | (z3[i] == a))) |
+            ((b == c) & ((x1[i] == b) | (x2[i] == b) | (x3[i] == b))) |
+            ((a == c) & ((y1[i] == a) | (y2[i] == a))));
+        hasMove[i] |= m;
+    }
+}
+
+// Oynanabilir hamle var mı? Dinlenmiş tahtada geçerli değişim, iki hücresi aynı olan
+// bir üçlü pencerenin eksik hücresine komşudan aynı türü getirmektir.
+static void HasMoveKernel(BatchEnv *env)
+{
+    memset(env->hasMove, 0, (size_t)env->stride);
+    for (int r = 0; r < ROWS; r++)
+    {
+        for (int c = 0; c < COLS; c++)
+        {
+            for (int dir = 0; dir < 2; dir++)
+            {
+                // dir 0: yatay pencere, 1: dikey; (pr, pc) pencereye dik yön
+                int dr = dir, dc = !dir, pr = !dir, pc = dir;
+                if (r + 2 * dr >= ROWS || c + 2 * dc >= COLS)
+                    continue;
+                const int8_t *nz[3] = {
+                    Lanes(env, r + 2 * dr - pr, c + 2 * dc - pc),
+                    Lanes(env, r + 2 * dr + pr, c + 2 * dc + pc),
+                    Lanes(env, r + 3 * dr, c + 3 * dc) };
+                const int8_t *nx[3] = {
+                    Lanes(env, r - pr, c - pc),
+                    Lanes(env, r + pr, c + pc),
+                    Lanes(env, r - dr, c - dc) };
+                const int8_t *ny[2] = {
+                    Lanes(env, r + dr - pr, c + dc - pc),
+                    Lanes(env, r + dr + pr, c + dc + pc) };
+                MoveWindow(env->stride, Lanes(env, r, c), Lanes(env, r + dr, c + dc),
+                    Lanes(env, r + 2 * dr, c + 2 * dc), nz, nx, ny, env->hasMove);
+            }
+        }
+    }
+}
+
+BatchEnv *BatchEnvCreate(int boardCount, uint64_t seed, int maxMoves)
+{
+    if (boardCount <= 0)
+        return NULL;
+    BatchEnv *env = calloc(1, sizeof(BatchEnv));
+    if (env == NULL)
+        return NULL;
+    env->count = boardCount;
+    env->stride = (boardCount + LANE_ALIGN - 1) / LANE_ALIGN * LANE_ALIGN;
+    env->maxMoves = maxMoves;
+    size_t n = (size_t)env->stride;
+    env->cells = AlignedCalloc(n * CELLS);
+    env->marked = AlignedCalloc(n * CELLS);
+    env->rng = AlignedCalloc(n * sizeof(uint32_t));
+    env->found = AlignedCalloc(n);
+    env->destroyed = AlignedCalloc(n);
+    env->hasMove = AlignedCalloc(n);
+    env->combo = AlignedCalloc(n * sizeof(int32_t));
+    env->moves = AlignedCalloc(n * sizeof(int32_t));
+    env->gained = AlignedCalloc(n * sizeof(int32_t));
+    env->outside = AlignedCalloc(n);
+    env->observations = AlignedCalloc((size_t)boardCount * CELLS);
+    env->rewards = AlignedCalloc((size_t)boardCount * sizeof(float));
+    env->dones = AlignedCalloc((size_t)boardCount);
+    if (!env->cells || !env->marked || !env->rng || !env->found || !env->destroyed || !env->hasMove ||
+        !env->combo || !env->moves || !env->gained || !env->outside || !env->observations ||
+        !env->rewards || !env->dones)
+    {
+        BatchEnvDestroy(env);
+        return NULL;
+    }
+    memset(env->outside, OUTSIDE_CELL, n);
+
+    // Kullanılmayan dolgu şeritleri de geçerli tahta tutar, çekirdekler onları da işler
+    Engine seeder;
+    EngineSeed(&seeder, seed);
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t x = (uint32_t)(seeder.rngState >> 32);
+        EngineRandomCandy(&seeder);
+        env->rng[i] = x ? x : 0x9E3779B9u;
+    }
+    BatchEnvReset(env);
+    return env;
+}
+
+void BatchEnvDestroy(BatchEnv *env)
+{
+    if (env == NULL)
+        return;
+    AlignedFree(env->cells);
+    AlignedFree(env->marked);
+    AlignedFree(env->rng);
+    AlignedFree(env->found);
+    AlignedFree(env->destroyed);
+    AlignedFree(env->hasMove);
+    AlignedFree(env->combo);
+    AlignedFree(env->moves);
+    AlignedFree(env->gained);
+    AlignedFree(env->outside);
+    AlignedFree(env->observations);
+    AlignedFree(env->rewards);
+    AlignedFree(env->dones);
+    free(env);
+}
+
+int BatchEnvSize(const BatchEnv *env)
+{
+    return env->count;
+}
+
+// SoA durumunu dışarıya [N][ROWS][COLS] olarak yaz
+static void WriteObservations(BatchEnv *env)
+{
+    const int n = env->stride;
+    for (int cell = 0; cell < CELLS; cell++)
+    {
+        const int8_t *t = env->cells + (size_t)cell * (size_t)n;
+        for (int i = 0; i < env->count; i++)
+            env->observations[(size_t)i * CELLS + (size_t)cell] = t[i];
+    }
+}
+
+void BatchEnvReset(BatchEnv *env)
+{
+    memset(env->marked, 0, (size_t)env->stride * CELLS);
+    for (int i = 0; i < env->stride; i++)
+    {
+        FillLane(env, i);
+        env->moves[i] = 0;
+        env->combo[i] = 1;
+    }
+    memset(env->rewards, 0, sizeof(float) * (size_t)env->count);
+    memset(env->dones, 0, (size_t)env->count);
+    WriteObservations(env);
+}
+
+void BatchEnvStep(BatchEnv *env, const int32_t *actions)
+{
+    const int n = env->stride;
+    for (int i = 0; i < n; i++)
+    {
+        env->gained[i] = 0;
+        env->combo[i] = 1;
+        if (i < env->count && LaneTrySwap(env, i, actions[i]))
+            env->moves[i]++;
+    }
+
+    // Tüm tahtalar aynı anda kaskad yapar; bitmiş olanlar çekirdeklerde değişmeden geçer
+    while (MarkKernel(env))
+    {
+        DestroyKernel(env);
+        GravityKernel(env);
+        RefillKernel(env);
+    }
+    memset(env->marked, 0, (size_t)n * CELLS);
+
+    // Oynanabilir hamle kalmayan tahtaları yeniden dağıt, hakkı bitenleri sıfırla
+    HasMoveKernel(env);
+    for (int i = 0; i < env->count; i++)
+    {
+        bool done = env->maxMoves > 0 && env->moves[i] >= env->maxMoves;
+        env->rewards[i] = (float)env->gained[i];
+        env->dones[i] = (uint8_t)done;
+        if (done)
+            env->moves[i] = 0;
+        if (done || !env->hasMove[i])
+            FillLane(env, i);
+    }
+    WriteObservations(env);
+}
+
+const int8_t *BatchEnvObservations(const BatchEnv *env)
+{
+    return env->observations;
+}
+
+const float *BatchEnvRewards(const BatchEnv *env)
+{
+    return env->rewards;
+}
+
+const uint8_t *BatchEnvDones(const BatchEnv *env)
+{
+    return env->dones;
+}
+
+void BatchEnvActionMask(const BatchEnv *env, uint8_t *mask)
+{
+    Engine e;
+    EngineLoadLevel(&e, NULL);
+    for (int i = 0; i < env->count; i++)
+    {
+        for (int r = 0; r < ROWS; r++)
+            memcpy(e.type[r], env->observations + (size_t)i * CELLS + (size_t)r * COLS, COLS);
+        for (int action = 0; action < BATCH_ACTIONS; action++)
+        {
+            int r0 = (action / 2) / COLS, c0 = (action / 2) % COLS;
+            Move m = { (int8_t)r0, (int8_t)c0, (int8_t)(r0 + (action & 1)), (int8_t)(c0 + !(action & 1)) };
+            bool inside = m.toRow < ROWS && m.toCol < COLS;
+            mask[(size_t)i * BATCH_ACTIONS + (size_t)action] = (uint8_t)(inside && EngineIsValidSwap(&e, m));
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef BATCHENV_H
+#define BATCHENV_H
+
+// Aynı anda N bağımsız tahtayı adımlayan toplu ortam (gym tarzı).
+// Düz C API: Python ctypes/cffi ile bağlanıp çıktı tamponlarını numpy dizisi
+// olarak kopyasız sarabilir (np.ctypeslib.as_array(ptr, shape)).
+//
+// Eylem kodu: (row * COLS + col) * 2 + yön, yön 0 = sağdaki, 1 = alttaki ile değiştir.
+// Bitmiş (done) tahtalar aynı adımda sıfırlanır; dönen gözlem yeni tahtadır.
+// Her tahtanın kendi üreteci vardır ve sadece o tahtanın ihtiyacı kadar ilerler:
+// aynı tohum ve şerit sırası ile aynı eylemler, toplu ortamın boyutu ve diğer
+// tahtalar ne olursa olsun aynı tahtaları verir.
+//
+// Derleme: cc -O3 -march=native -std=c11 -shared -fPIC batchenv.c engine.c arena.c eventbus.c -o libbatchenv.so
+
+#include "engine.h"
+
+#define BATCH_ACTIONS (2 * ROWS * COLS)
+
+typedef struct BatchEnv BatchEnv;
+
+BatchEnv *BatchEnvCreate(int boardCount, uint64_t seed, int maxMoves);
+void BatchEnvDestroy(BatchEnv *env);
+int BatchEnvSize(const BatchEnv *env);
+
+// Tüm tahtaları yeniden dağıt
+void BatchEnvReset(BatchEnv *env);
+
+// actions[N] uygula; sonuçlar aşağıdaki tamponlara yazılır
+void BatchEnvStep(BatchEnv *env, const int32_t *actions);
+
+// Ortamın sahip olduğu, her adımda yerinde güncellenen tamponlar
+const int8_t *BatchEnvObservations(const BatchEnv *env); // [N][ROWS][COLS] şeker türü
+const float *BatchEnvRewards(const BatchEnv *env);       // [N] bu adımda kazanılan puan
+const uint8_t *BatchEnvDones(const BatchEnv *env);       // [N] 1 = hamle hakkı bitti
+
+// Geçerli eylemler maskesi: mask[N][BATCH_ACTIONS], 1 = eşleşme yaratır
+void BatchEnvActionMask(const BatchEnv *env, uint8_t *mask);
+
+#endif
@@ -0,0 +1,154 @@
+#include "boardbank.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+uint32_t BoardBankLevelHash(const char *layout)
+{
+    if (layout == NULL)
+        return 0;
+    uint32_t hash = 2166136261u;
+    for (const char *p = layout; *p != '\0'; p++)
+        hash = (hash ^ (unsigned char)*p) * 16777619u;
+    return hash;
+}
+
+static bool Validate(BoardBank *bank)
+{
+    if (bank->size < sizeof(BoardBankHeader))
+        return false;
+    const BoardBankHeader *header = (const BoardBankHeader *)bank->data;
+    if (header->magic != BOARD_BANK_MAGIC || header->version != BOARD_BANK_VERSION)
+        return false;
+    size_t directoryEnd = sizeof(BoardBankHeader) + (size_t)header->bankCount * sizeof(BoardBankEntry);
+    if (directoryEnd > bank->size)
+        return false;
+
+    const BoardBankEntry *entries = (const BoardBankEntry *)(bank->data + sizeof(BoardBankHeader));
+    for (int i = 0; i < header->bankCount; i++)
+    {
+        const BoardBankEntry *entry = &entries[i];
+        if (entry->rows < 1 || entry->rows > MAX_ROWS || entry->cols < 1 || entry->cols > MAX_COLS ||
+            entry->boardCount == 0 || entry->boardBytes != (uint32_t)(entry->rows * entry->cols + 1) / 2)
+            return false;
+        if (entry->offset < directoryEnd || entry->offset > bank->size ||
+            (uint64_t)entry->boardCount * entry->boardBytes > bank->size - entry->offset)
+            return false;
+    }
+    bank->entries = entries;
+    bank->bankCount = header->bankCount;
+    return true;
+}
+
+bool BoardBankOpen(BoardBank *bank, const char *path)
+{
+    memset(bank, 0, sizeof(*bank));
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+    bank->data = data;
+    bank->size = (size_t)info.st_size;
+    bank->mapped = true;
+#else
+    // Windows'ta eşleme yerine tek okuma; dosya birkaç MB
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return false;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t *data = size > 0 ? malloc((size_t)size) : NULL;
+    bool read = data != NULL && fread(data, (size_t)size, 1, file) == 1;
+    fclose(file);
+    if (!read)
+    {
+        free(data);
+        return false;
+    }
+    bank->data = data;
+    bank->size = (size_t)size;
+#endif
+
+    if (!Validate(bank))
+    {
+        BoardBankClose(bank);
+        return false;
+    }
+    return true;
+}
+
+void BoardBankClose(BoardBank *bank)
+{
+    if (bank->data != NULL)
+    {
+#ifndef _WIN32
+        if (bank->mapped)
+            munmap((void *)bank->data, bank->size);
+#endif
+        if (!bank->mapped)
+            free((void *)bank->data);
+    }
+    memset(bank, 0, sizeof(*bank));
+}
+
+const BoardBankEntry *BoardBankFind(const BoardBank *bank, uint32_t levelHash, int tier)
+{
+    for (int i = 0; i < bank->bankCount; i++)
+        if (bank->entries[i].levelHash == levelHash && bank->entries[i].tier == tier)
+            return &bank->entries[i];
+    return NULL;
+}
+
+bool BoardBankDeal(const BoardBank *bank, const BoardBankEntry *entry, Engine *e)
+{
+    if (entry == NULL || entry->rows != e->rows || entry->cols != e->cols)
+        return false;
+    uint32_t index = (uint32_t)((EngineRandom(e) >> 32) % entry->boardCount);
+    const uint8_t *packed = bank->data + entry->offset + (size_t)index * entry->boardBytes;
+
+    // Önce düzeni doğrula, sonra yaz: uyuşmazlıkta tahta yarım kalmasın
+    int8_t type[MAX_ROWS][MAX_COLS];
+    for (int i = 0; i < e->rows * e->cols; i++)
+    {
+        int r = i / e->cols, c = i % e->cols;
+        int value = (packed[i / 2] >> (4 * (i & 1))) & 0xF;
+        bool playable = e->kind[r][c] == CELL_PLAYABLE;
+        if (playable != (value < CANDY_TYPES) || (!playable && value != BOARD_BANK_BLOCKED))
+            return false;
+        type[r][c] = playable ? (int8_t)value : BLOCKED_CELL;
+    }
+    for (int r = 0; r < e->rows; r++)
+        memcpy(e->type[r], type[r], (size_t)e->cols);
+    EngineResetMarks(e);
+    memset(e->fall, 0, sizeof(e->fall));
+    return true;
+}
+
+void BoardBankPack(const Engine *e, uint8_t *out)
+{
+    memset(out, 0, (size_t)(e->rows * e->cols + 1) / 2);
+    for (int i = 0; i < e->rows * e->cols; i++)
+    {
+        int8_t type = e->type[i / e->cols][i % e->cols];
+        int value = type >= 0 ? type : BOARD_BANK_BLOCKED;
+        out[i / 2] |= (uint8_t)(value << (4 * (i & 1)));
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef BOARDBANK_H
+#define BOARDBANK_H
+
+// Önceden üretilmiş başlangıç tahtaları (boardgen.c yazar, oyun okur).
+// Dosya: başlık, bank dizini, ardından her bankın tahtaları arka arkaya.
+// Bir bank = bir seviye düzeni + bir zorluk kademesi; tüm tahtaları aynı boyutta
+// olduğundan i. tahta offset + i * boardBytes adresindedir (O(1) seçim).
+// Tahta satır satır hücre başına 4 bit: şeker türü, BOARD_BANK_BLOCKED = şekersiz hücre.
+// Sayılar yerel bayt sırasında yazılır (x86/ARM küçük uçlu).
+
+#include "engine.h"
+#include <stddef.h>
+
+#define BOARD_BANK_MAGIC 0x42424343u // "CCBB"
+#define BOARD_BANK_VERSION 1
+#define BOARD_BANK_BLOCKED 0xF
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t bankCount;
+} BoardBankHeader;
+
+typedef struct
+{
+    uint32_t levelHash; // BoardBankLevelHash(düzen metni), varsayılan tahta 0
+    uint8_t rows, cols;
+    uint8_t tier;       // 0 = en kolay
+    uint8_t minMoves;   // Her tahtada en az bu kadar geçerli hamle var
+    uint32_t boardCount;
+    uint32_t boardBytes;
+    uint64_t offset;    // Dosya başından ilk tahtaya
+} BoardBankEntry;
+
+typedef struct
+{
+    const uint8_t *data;
+    size_t size;
+    const BoardBankEntry *entries;
+    int bankCount;
+    bool mapped; // false ise data heap'te
+} BoardBank;
+
+// Düzen metninin FNV-1a özeti; kayıt dosyası da aynı özeti kullanır
+uint32_t BoardBankLevelHash(const char *layout);
+
+// Dosyayı belleğe eşler ve dizini doğrular; yoksa ya da bozuksa false (bank boş kalır)
+bool BoardBankOpen(BoardBank *bank, const char *path);
+void BoardBankClose(BoardBank *bank);
+
+// Seviye ve kademe için bank, yoksa NULL
+const BoardBankEntry *BoardBankFind(const BoardBank *bank, uint32_t levelHash, int tier);
+
+// Banktan rastgele bir tahtayı e->type'a açar (e->rngState ile seçilir).
+// Düzen bankınkiyle uyuşmazsa tahta değişmez ve false döner.
+bool BoardBankDeal(const BoardBank *bank, const BoardBankEntry *entry, Engine *e);
+
+// Üretici için: e'nin tahtasını boardBytes baytına paketle
+void BoardBankPack(const Engine *e, uint8_t *out);
+
+#endif
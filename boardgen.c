@@ -0,0 +1,312 @@
+// Çevrimdışı başlangıç tahtası üreteci: her seviye için tüm çekirdeklerle aday tahta
+// üretir, eşleşmesiz ve en az --min-moves geçerli hamlesi olanları zorluğa göre
+// sıralar, eşit büyüklükte kademelere bölüp tek bank dosyasına yazar (biçim boardbank.h).
+//
+// Zorluk: tahtadan rastgele oynanan kısa oyunlarda hamle başına ortalama puan;
+// puanı düşük tahta zor. Kademe 0 en kolay.
+// Her aday kendi sırasından tohumlanır, sonuç iş parçacığı sayısından bağımsızdır.
+//
+// Derleme (Linux): cc -O2 -std=c11 boardgen.c boardbank.c engine.c arena.c eventbus.c -o boardgen -lpthread
+// Kullanım: ./boardgen [--out boards.bin] [--count 4096] [--tiers 3] [--min-moves 3]
+//                      [--threads N] [--seed 1] [levels/jelly.txt ...]
+// Seviye verilmezse ya da "-" verilirse varsayılan 8x8 tahta; grokai bankı seviye metninin özetiyle bulur.
+
+#define _GNU_SOURCE
+#include "boardbank.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_THREADS 64
+#define MAX_LEVELS 64
+#define MAX_TIERS 8
+#define PLAYOUTS 8
+#define PLAYOUT_MOVES 10
+#define MAX_MIN_MOVE_ATTEMPTS 10000 // Düzen bu kadar denemede --min-moves sağlamıyorsa vazgeç
+#define OUT_TEMP_SUFFIX ".tmp"
+
+typedef struct
+{
+    const char *path;  // NULL = varsayılan tahta
+    char *text;
+    Engine layout;     // Boş düzen, adaylar bundan kopyalanır
+    uint32_t hash;
+    int candidates;
+    int boardBytes;
+    uint8_t *boards;   // [candidates][boardBytes]
+    float *score;      // [candidates]
+    int *validMoves;   // [candidates]
+    int *order;        // Zorluk sırası, kolaydan zora
+    atomic_int failed; // --min-moves'u sağlayamayan aday sayısı
+} Level;
+
+typedef struct
+{
+    Level *level;
+    int levelIndex;
+    int first, step; // first, first + step, ... adayları
+} Job;
+
+static int boardsPerTier = 4096;
+static int tierCount = 3;
+static int minMoves = 3;
+static int threadCount = 0;
+static uint64_t seed = 1;
+static const char *outPath = "boards.bin";
+
+static uint64_t Mix(uint64_t a, uint64_t b)
+{
+    uint64_t z = a ^ (b + 0x9E3779B97F4A7C15ull + (a << 6) + (a >> 2));
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Rastgele hamlelerle kısa oyunlar; hamle başına ortalama puan
+static float Playout(const Engine *start, uint64_t playoutSeed)
+{
+    int total = 0, moves = 0;
+    for (int p = 0; p < PLAYOUTS; p++)
+    {
+        Engine e = *start;
+        EngineSeed(&e, Mix(playoutSeed, (uint64_t)p));
+        for (int m = 0; m < PLAYOUT_MOVES; m++)
+        {
+            MoveList list;
+            if (EngineGenerateMoves(&e, &list) == 0)
+                break;
+            int gained = EngineStep(&e, list.moves[EngineRandom(&e) % (uint64_t)list.count], NULL, NULL);
+            if (gained < 0)
+                break;
+            total += gained;
+            moves++;
+        }
+    }
+    return moves > 0 ? (float)total / (float)moves : 0.0f;
+}
+
+static int GenerateThread(void *arg)
+{
+    Job *job = arg;
+    Level *level = job->level;
+    for (int i = job->first; i < level->candidates; i += job->step)
+    {
+        Engine e = level->layout;
+        EngineSeed(&e, Mix(Mix(seed, (uint64_t)job->levelIndex), (uint64_t)i));
+        MoveList list;
+        int attempts = 0;
+        bool dealt;
+        do
+            dealt = EngineFillNoMatches(&e);
+        while (EngineGenerateMoves(&e, &list) < minMoves && dealt && ++attempts < MAX_MIN_MOVE_ATTEMPTS);
+        if (!dealt || attempts == MAX_MIN_MOVE_ATTEMPTS)
+            atomic_fetch_add(&level->failed, 1);
+
+        BoardBankPack(&e, level->boards + (size_t)i * (size_t)level->boardBytes);
+        level->validMoves[i] = list.count;
+        level->score[i] = Playout(&e, Mix(seed ^ 0x5EED, (uint64_t)i));
+    }
+    return 0;
+}
+
+static Level *sortLevel;
+
+// Yüksek puan (kolay) önce; eşitlikte sıra numarası, sonuç kararlı olsun
+static int CompareDifficulty(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    if (sortLevel->score[x] != sortLevel->score[y])
+        return sortLevel->score[x] > sortLevel->score[y] ? -1 : 1;
+    return x - y;
+}
+
+static char *ReadText(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return NULL;
+    size_t capacity = 4096, length = 0;
+    char *text = malloc(capacity);
+    size_t got;
+    while (text != NULL && (got = fread(text + length, 1, capacity - length - 1, file)) > 0)
+    {
+        length += got;
+        if (capacity - length - 1 == 0)
+        {
+            char *grown = realloc(text, capacity * 2);
+            if (grown == NULL)
+                free(text);
+            text = grown;
+            capacity *= 2;
+        }
+    }
+    fclose(file);
+    if (text != NULL)
+        text[length] = '\0';
+    return text;
+}
+
+static bool PrepareLevel(Level *level, const char *path)
+{
+    memset(level, 0, sizeof(*level));
+    level->path = path;
+    if (path != NULL && (level->text = ReadText(path)) == NULL)
+    {
+        fprintf(stderr, "%s okunamadı\n", path);
+        return false;
+    }
+    if (!EngineLoadLevel(&level->layout, level->text))
+    {
+        fprintf(stderr, "%s geçerli bir seviye düzeni değil\n", path);
+        return false;
+    }
+    level->hash = BoardBankLevelHash(level->text);
+    level->candidates = boardsPerTier * tierCount;
+    level->boardBytes = (level->layout.rows * level->layout.cols + 1) / 2;
+    level->boards = malloc((size_t)level->candidates * (size_t)level->boardBytes);
+    level->score = malloc(sizeof(float) * (size_t)level->candidates);
+    level->validMoves = malloc(sizeof(int) * (size_t)level->candidates);
+    level->order = malloc(sizeof(int) * (size_t)level->candidates);
+    return level->boards != NULL && level->score != NULL && level->validMoves != NULL && level->order != NULL;
+}
+
+static void GenerateLevel(Level *level, int levelIndex)
+{
+    static Job jobs[MAX_THREADS];
+    thrd_t threads[MAX_THREADS];
+    for (int t = 0; t < threadCount; t++)
+    {
+        jobs[t] = (Job){ level, levelIndex, t, threadCount };
+        thrd_create(&threads[t], GenerateThread, &jobs[t]);
+    }
+    for (int t = 0; t < threadCount; t++)
+        thrd_join(threads[t], NULL);
+
+    for (int i = 0; i < level->candidates; i++)
+        level->order[i] = i;
+    sortLevel = level;
+    qsort(level->order, (size_t)level->candidates, sizeof(int), CompareDifficulty);
+}
+
+static void PrintLevel(const Level *level)
+{
+    printf("%s (%dx%d, özet %08x)\n", level->path != NULL ? level->path : "varsayılan tahta",
+        level->layout.rows, level->layout.cols, level->hash);
+    for (int t = 0; t < tierCount; t++)
+    {
+        const int *order = level->order + t * boardsPerTier;
+        double moves = 0.0;
+        for (int i = 0; i < boardsPerTier; i++)
+            moves += level->validMoves[order[i]];
+        printf("  kademe %d: puan/hamle %.1f .. %.1f, ortalama %.1f geçerli hamle\n", t,
+            level->score[order[0]], level->score[order[boardsPerTier - 1]], moves / boardsPerTier);
+    }
+}
+
+// Geçici dosyaya yaz, sonra eskisinin üzerine taşı
+static bool WriteBank(const Level *levels, int levelCount)
+{
+    char tempPath[512];
+    snprintf(tempPath, sizeof(tempPath), "%s%s", outPath, OUT_TEMP_SUFFIX);
+    FILE *file = fopen(tempPath, "wb");
+    if (file == NULL)
+        return false;
+
+    BoardBankHeader header = { BOARD_BANK_MAGIC, BOARD_BANK_VERSION, (uint16_t)(levelCount * tierCount) };
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    uint64_t offset = sizeof(header) + sizeof(BoardBankEntry) * (uint64_t)header.bankCount;
+    for (int l = 0; l < levelCount; l++)
+    {
+        for (int t = 0; t < tierCount; t++)
+        {
+            const Level *level = &levels[l];
+            BoardBankEntry entry = { level->hash, (uint8_t)level->layout.rows, (uint8_t)level->layout.cols,
+                (uint8_t)t, (uint8_t)minMoves, (uint32_t)boardsPerTier, (uint32_t)level->boardBytes, offset };
+            ok = ok && fwrite(&entry, sizeof(entry), 1, file) == 1;
+            offset += (uint64_t)boardsPerTier * (uint64_t)level->boardBytes;
+        }
+    }
+    for (int l = 0; l < levelCount; l++)
+    {
+        const Level *level = &levels[l];
+        for (int i = 0; i < level->candidates && ok; i++)
+            ok = fwrite(level->boards + (size_t)level->order[i] * (size_t)level->boardBytes,
+                (size_t)level->boardBytes, 1, file) == 1;
+    }
+    ok = (fclose(file) == 0) && ok;
+    return ok && rename(tempPath, outPath) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    static const char *levelPaths[MAX_LEVELS];
+    int levelCount = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--", 2) == 0 && i + 1 < argc)
+        {
+            const char *value = argv[++i];
+            if (strcmp(argv[i - 1], "--out") == 0)
+                outPath = value;
+            else if (strcmp(argv[i - 1], "--count") == 0)
+                boardsPerTier = atoi(value);
+            else if (strcmp(argv[i - 1], "--tiers") == 0)
+                tierCount = atoi(value);
+            else if (strcmp(argv[i - 1], "--min-moves") == 0)
+                minMoves = atoi(value);
+            else if (strcmp(argv[i - 1], "--threads") == 0)
+                threadCount = atoi(value);
+            else if (strcmp(argv[i - 1], "--seed") == 0)
+                seed = strtoull(value, NULL, 10);
+        }
+        else if (levelCount < MAX_LEVELS)
+        {
+            levelPaths[levelCount++] = strcmp(argv[i], "-") == 0 ? NULL : argv[i];
+        }
+    }
+    if (levelCount == 0)
+        levelPaths[levelCount++] = NULL;
+    if (threadCount <= 0)
+        threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threadCount > MAX_THREADS)
+        threadCount = MAX_THREADS;
+    if (boardsPerTier < 1 || tierCount < 1 || tierCount > MAX_TIERS || minMoves < 1 || minMoves > 255 ||
+        levelCount * tierCount > UINT16_MAX)
+    {
+        fprintf(stderr, "--count >= 1, --tiers 1..%d ve --min-moves 1..255 olmalı\n", MAX_TIERS);
+        return 1;
+    }
+
+    static Level levels[MAX_LEVELS];
+    struct timespec start, end;
+    timespec_get(&start, TIME_UTC);
+    for (int l = 0; l < levelCount; l++)
+    {
+        if (!PrepareLevel(&levels[l], levelPaths[l]))
+            return 1;
+        GenerateLevel(&levels[l], l);
+        if (atomic_load(&levels[l].failed) > 0)
+        {
+            fprintf(stderr, "%s: %d denemede %d geçerli hamleli tahta bulunamadı\n",
+                levelPaths[l] != NULL ? levelPaths[l] : "varsayılan tahta", MAX_MIN_MOVE_ATTEMPTS, minMoves);
+            return 1;
+        }
+        PrintLevel(&levels[l]);
+    }
+    timespec_get(&end, TIME_UTC);
+    double elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+    long long total = (long long)levelCount * tierCount * boardsPerTier;
+    printf("%lld tahta, %d iş parçacığı, %.2f s (%.0f tahta/s)\n", total, threadCount, elapsed, (double)total / elapsed);
+
+    if (!WriteBank(levels, levelCount))
+    {
+        fprintf(stderr, "%s yazılamadı\n", outPath);
+        return 1;
+    }
+    printf("%s yazıldı\n", outPath);
+    return 0;
+}
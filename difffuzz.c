@@ -0,0 +1,757 @@
+// Diferansiyel bulanık test: ilk grokai.c sürümündeki kuralların birebir kopyası (Ref*)
+// ile engine.c'yi aynı tohumlu tahta ve hamle dizilerinde yan yana çalıştırır.
+// Hamlelerden önce tüm komşu takasların geçerliliği ve HasValidMove, hamlede ise
+// kazanılan puan, kaskad adımları (arenaya kaydedilen farklar dahil), tahta ve
+// rastgele üretecin durumu karşılaştırılır. Ayrışma bulununca vaka en küçük tahta ve
+// hamle listesine indirgenip yazdırılır.
+//
+// Referans sadece varsayılan 8x8 tahtayı bilir; delik/engel/geçit ve batchenv'in
+// kendi üreteciyle dolan tahtaları bu testin dışında.
+//
+// Derleme (Linux): cc -O2 -std=c11 difffuzz.c engine.c arena.c eventbus.c -o difffuzz -lpthread
+// Kullanım: ./difffuzz [--cases 100000] [--moves 64] [--threads N] [--seed 1] [--sweep-every 4]
+//   Varsayılanlar tek çekirdekte ~2 dakika sürer (~60k hamle/s); çekirdek sayısıyla ölçeklenir.
+//   Tüm takasların geçerlilik taraması her --sweep-every hamlede bir yapılır (1 = her hamlede,
+//   yarı hızda); aradaki hamleler motorun listesinden seçilir, uygulanan hamle her zaman karşılaştırılır.
+// libFuzzer: clang -g -O1 -fsanitize=fuzzer,address -DDIFFFUZZ_LIBFUZZER difffuzz.c engine.c arena.c eventbus.c
+//   Girdi: 8 bayt tohum, ardından hamle başına 1 bayt (DecodeMove).
+
+#define _GNU_SOURCE
+#include "engine.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_THREADS 64
+#define MAX_CASE_MOVES 256
+#define CASES_PER_CLAIM 256
+#define ARENA_BYTES (64 * 1024)
+#define MAX_REF_STEPS 64 // Daha uzun kaskadların adımları karşılaştırılmaz, toplamları yine karşılaştırılır
+
+static int sweepEvery = 4;
+
+// ---------------------------------------------------------------------------
+// Referans model: temel sürümdeki grokai.c fonksiyonları, küresel tahta yerine
+// RefBoard üzerinde. GetRandomValue yerine motorun xorshift64* üreteci kullanılır,
+// böylece yeniden doldurma aynı şekerleri verir. İşaretler de birebir aynı davranır:
+// MarkMatches temizlemez, düşen şeker işaretini taşır, doldurma işarete dokunmaz.
+
+typedef struct
+{
+    int8_t type[ROWS][COLS];
+    bool marked[ROWS][COLS];
+    int score;
+    int comboMultiplier;
+    uint64_t rngState;
+} RefBoard;
+
+static void RefSeed(RefBoard *b, uint64_t seed)
+{
+    uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    b->rngState = z ? z : 0x9E3779B97F4A7C15ull;
+}
+
+static int RefRandomCandy(RefBoard *b)
+{
+    b->rngState ^= b->rngState >> 12;
+    b->rngState ^= b->rngState << 25;
+    b->rngState ^= b->rngState >> 27;
+    return (int)(((b->rngState * 0x2545F4914F6CDD1Dull) >> 32) % CANDY_TYPES);
+}
+
+static bool RefIsAdjacent(Move m)
+{
+    return (abs(m.fromRow - m.toRow) == 1 && m.fromCol == m.toCol) ||
+        (abs(m.fromCol - m.toCol) == 1 && m.fromRow == m.toRow);
+}
+
+static void RefSwap(RefBoard *b, Move m)
+{
+    int8_t type = b->type[m.fromRow][m.fromCol];
+    bool marked = b->marked[m.fromRow][m.fromCol];
+    b->type[m.fromRow][m.fromCol] = b->type[m.toRow][m.toCol];
+    b->marked[m.fromRow][m.fromCol] = b->marked[m.toRow][m.toCol];
+    b->type[m.toRow][m.toCol] = type;
+    b->marked[m.toRow][m.toCol] = marked;
+}
+
+static void RefResetDestroyFlags(RefBoard *b)
+{
+    memset(b->marked, 0, sizeof(b->marked));
+}
+
+static bool RefMarkMatches(RefBoard *b)
+{
+    bool found = false;
+    for (int r = 0; r < ROWS; r++)
+    {
+        int count = 1;
+        for (int c = 1; c < COLS; c++)
+        {
+            if (b->type[r][c] == b->type[r][c - 1])
+                count++;
+            else
+                count = 1;
+            if (count >= 3)
+            {
+                found = true;
+                for (int k = 0; k < count; k++)
+                    b->marked[r][c - k] = true;
+            }
+        }
+    }
+    for (int c = 0; c < COLS; c++)
+    {
+        int count = 1;
+        for (int r = 1; r < ROWS; r++)
+        {
+            if (b->type[r][c] == b->type[r - 1][c])
+                count++;
+            else
+                count = 1;
+            if (count >= 3)
+            {
+                found = true;
+                for (int k = 0; k < count; k++)
+                    b->marked[r - k][c] = true;
+            }
+        }
+    }
+    return found;
+}
+
+static int RefDestroyMarked(RefBoard *b)
+{
+    int destroyed = 0;
+    for (int r = 0; r < ROWS; r++)
+    {
+        for (int c = 0; c < COLS; c++)
+        {
+            if (b->marked[r][c])
+            {
+                destroyed++;
+                b->type[r][c] = EMPTY_CELL;
+            }
+        }
+    }
+    return destroyed;
+}
+
+static void RefDropCandies(RefBoard *b)
+{
+    for (int c = 0; c < COLS; c++)
+    {
+        for (int r = ROWS - 1; r >= 0; r--)
+        {
+            if (b->type[r][c] == EMPTY_CELL)
+            {
+                int rr = r - 1;
+                while (rr >= 0 && b->type[rr][c] == EMPTY_CELL)
+                    rr--;
+                if (rr >= 0)
+                {
+                    b->type[r][c] = b->type[rr][c];
+                    b->marked[r][c] = b->marked[rr][c];
+                    b->type[rr][c] = EMPTY_CELL;
+                }
+            }
+        }
+    }
+    for (int c = 0; c < COLS; c++)
+        for (int r = 0; r < ROWS; r++)
+            if (b->type[r][c] == EMPTY_CELL)
+                b->type[r][c] = (int8_t)RefRandomCandy(b);
+}
+
+static bool RefIsValidSwap(RefBoard *b, Move m)
+{
+    RefSwap(b, m);
+    bool valid = RefMarkMatches(b);
+    RefSwap(b, m);
+    RefResetDestroyFlags(b);
+    return valid;
+}
+
+static bool RefHasValidMove(RefBoard *b)
+{
+    for (int r = 0; r < ROWS; r++)
+    {
+        for (int c = 0; c < COLS; c++)
+        {
+            if (c < COLS - 1 && RefIsValidSwap(b, (Move){ r, c, r, c + 1 }))
+                return true;
+            if (r < ROWS - 1 && RefIsValidSwap(b, (Move){ r, c, r + 1, c }))
+                return true;
+        }
+    }
+    return false;
+}
+
+static void RefFillNoMatches(RefBoard *b)
+{
+    do
+    {
+        for (int r = 0; r < ROWS; r++)
+            for (int c = 0; c < COLS; c++)
+                b->type[r][c] = (int8_t)RefRandomCandy(b);
+        RefResetDestroyFlags(b);
+        RefMarkMatches(b);
+    } while (RefMarkMatches(b) || !RefHasValidMove(b));
+    RefResetDestroyFlags(b);
+}
+
+static void RefAddScore(RefBoard *b, int destroyed)
+{
+    if (destroyed == 3)
+        b->score += 60 * b->comboMultiplier;
+    else if (destroyed == 4)
+        b->score += 100 * b->comboMultiplier;
+    else if (destroyed >= 5)
+        b->score += 200 * b->comboMultiplier;
+}
+
+// Oyun döngüsündeki sırayla: tıklama doğrulaması, takas, kaskad, gerekirse yeniden dağıtma
+static int RefStep(RefBoard *b, Move m, int *steps, int *destroyedPerStep)
+{
+    *steps = 0;
+    if (m.fromRow < 0 || m.fromRow >= ROWS || m.fromCol < 0 || m.fromCol >= COLS ||
+        m.toRow < 0 || m.toRow >= ROWS || m.toCol < 0 || m.toCol >= COLS)
+        return -1;
+    if (!RefIsAdjacent(m) || !RefIsValidSwap(b, m))
+        return -1;
+
+    int before = b->score;
+    RefSwap(b, m);
+    RefResetDestroyFlags(b);
+    RefMarkMatches(b);
+    b->comboMultiplier = 1;
+    while (RefMarkMatches(b))
+    {
+        int destroyed = RefDestroyMarked(b);
+        RefAddScore(b, destroyed);
+        RefDropCandies(b);
+        b->comboMultiplier++;
+        if (*steps < MAX_REF_STEPS)
+            destroyedPerStep[*steps] = destroyed;
+        (*steps)++;
+    }
+    RefResetDestroyFlags(b);
+    b->comboMultiplier = 1;
+    if (!RefHasValidMove(b))
+        RefFillNoMatches(b);
+    return b->score - before;
+}
+
+// ---------------------------------------------------------------------------
+// Vakalar
+
+typedef struct
+{
+    uint64_t seed;
+    bool explicitBoard; // İndirgenmiş vaka: tohum yerine doğrudan tahta
+    int8_t board[ROWS][COLS];
+    uint64_t rngState;
+    int moveCount;
+    uint8_t moves[MAX_CASE_MOVES];
+} FuzzCase;
+
+typedef struct
+{
+    int move; // Ayrışan hamlenin sırası, -1 = başlangıç tahtası
+    char what[160];
+} Divergence;
+
+typedef struct
+{
+    Arena arena;
+    _Alignas(16) unsigned char memory[ARENA_BYTES];
+} Scratch;
+
+// Referansın geçerli hamleleri, EngineGenerateMoves ile aynı sırada (hücre hücre, önce sağ sonra alt)
+static int RefValidMoves(RefBoard *ref, Move valid[MAX_MOVES])
+{
+    int count = 0;
+    for (int r = 0; r < ROWS; r++)
+    {
+        for (int c = 0; c < COLS; c++)
+        {
+            if (c < COLS - 1 && RefIsValidSwap(ref, (Move){ r, c, r, c + 1 }))
+                valid[count++] = (Move){ r, c, r, c + 1 };
+            if (r < ROWS - 1 && RefIsValidSwap(ref, (Move){ r, c, r + 1, c }))
+                valid[count++] = (Move){ r, c, r + 1, c };
+        }
+    }
+    return count;
+}
+
+// Bayt < 0x80: referansın geçerli hamle listesinden (bayt % sayı). sıradaki;
+// bayt >= 0x80: hücre (bayt >> 1) & 63 ile sağındaki (bit 0 = 0) ya da altındaki,
+// kenarda tahta dışına taşabilir. Geçerli hamle yoksa false.
+static bool DecodeMove(const Move *valid, int count, uint8_t code, Move *out)
+{
+    if (code & 0x80)
+    {
+        int cell = (code >> 1) & 63, r = cell / COLS, c = cell % COLS;
+        *out = (code & 1) ? (Move){ r, c, r + 1, c } : (Move){ r, c, r, c + 1 };
+        return true;
+    }
+    if (count == 0)
+        return false;
+    *out = valid[code % count];
+    return true;
+}
+
+static uint8_t EncodeMove(Move m)
+{
+    return (uint8_t)(0x80 | ((m.fromRow * COLS + m.fromCol) << 1) | (m.toRow != m.fromRow));
+}
+
+static void Setup(const FuzzCase *c, Engine *e, RefBoard *ref)
+{
+    memset(ref, 0, sizeof(*ref));
+    ref->comboMultiplier = 1;
+    if (!c->explicitBoard)
+    {
+        EngineInit(e, c->seed);
+        RefSeed(ref, c->seed);
+        RefFillNoMatches(ref);
+        return;
+    }
+    EngineInit(e, 0);
+    for (int r = 0; r < ROWS; r++)
+        memcpy(e->type[r], c->board[r], COLS);
+    memcpy(ref->type, c->board, sizeof(ref->type));
+    e->rngState = ref->rngState = c->rngState;
+}
+
+static bool SameBoard(const Engine *e, const RefBoard *ref, Divergence *d, int move)
+{
+    for (int r = 0; r < ROWS; r++)
+    {
+        for (int c = 0; c < COLS; c++)
+        {
+            if (e->type[r][c] != ref->type[r][c])
+            {
+                d->move = move;
+                snprintf(d->what, sizeof(d->what), "tahta (%d,%d): motor %d, referans %d", r, c, e->type[r][c], ref->type[r][c]);
+                return false;
+            }
+        }
+    }
+    if (e->rngState != ref->rngState)
+    {
+        d->move = move;
+        snprintf(d->what, sizeof(d->what), "üretec durumu farklı (farklı sayıda şeker çekildi)");
+        return false;
+    }
+    if (e->score != ref->score)
+    {
+        d->move = move;
+        snprintf(d->what, sizeof(d->what), "skor: motor %d, referans %d", e->score, ref->score);
+        return false;
+    }
+    return true;
+}
+
+static bool ContainsMove(const Move *moves, int count, Move m)
+{
+    for (int i = 0; i < count; i++)
+        if (memcmp(&moves[i], &m, sizeof(Move)) == 0)
+            return true;
+    return false;
+}
+
+// Tüm komşu takasların geçerliliği: motorun hamle listesi referansınkiyle birebir aynı olmalı.
+// Referans listesi hamle çözmek için zaten hesaplandığından tarama hamle başına bir kez yapılır;
+// takas takas EngineIsValidSwap sadece fark bulunursa raporlamak için çağrılır.
+static bool SameMoves(Engine *e, const Move *valid, int count, Divergence *d, int move)
+{
+    MoveList list;
+    if (EngineGenerateMoves(e, &list) != count || memcmp(list.moves, valid, sizeof(Move) * (size_t)count) != 0)
+    {
+        d->move = move;
+        snprintf(d->what, sizeof(d->what), "GenerateMoves: motor %d hamle, referans %d", list.count, count);
+        for (int r = 0; r < ROWS; r++)
+        {
+            for (int c = 0; c < COLS; c++)
+            {
+                for (int dir = 0; dir < 2; dir++)
+                {
+                    Move m = dir ? (Move){ r, c, r + 1, c } : (Move){ r, c, r, c + 1 };
+                    if (m.toRow >= ROWS || m.toCol >= COLS)
+                        continue;
+                    bool expected = ContainsMove(valid, count, m);
+                    if (EngineIsValidSwap(e, m) != expected)
+                    {
+                        snprintf(d->what, sizeof(d->what), "IsValidSwap (%d,%d)-(%d,%d): motor %d, referans %d",
+                            m.fromRow, m.fromCol, m.toRow, m.toCol, !expected, expected);
+                        return false;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+    if (EngineHasValidMove(e) != (count > 0))
+    {
+        d->move = move;
+        snprintf(d->what, sizeof(d->what), "HasValidMove: motor %d, referans %d", count == 0, count > 0);
+        return false;
+    }
+    return true;
+}
+
+// Hamle çözmek için geçerli hamleler: tarama hamlesinde referanstan (SameMoves motorunkiyle
+// karşılaştırır), arada motorun hızlı listesinden. İndirgeme de aynı seçimi yapsın diye ortak.
+static int ListMoves(Engine *e, RefBoard *ref, int move, Move valid[MAX_MOVES])
+{
+    if (move % sweepEvery == 0)
+        return RefValidMoves(ref, valid);
+    MoveList list;
+    EngineGenerateMoves(e, &list);
+    memcpy(valid, list.moves, sizeof(Move) * (size_t)list.count);
+    return list.count;
+}
+
+// Vakayı iki tarafta oynat; ayrışma yoksa true
+static bool RunCase(const FuzzCase *c, Scratch *scratch, Divergence *d, long long *movesPlayed)
+{
+    static _Thread_local Engine e;
+    RefBoard ref;
+    Setup(c, &e, &ref);
+    if (!SameBoard(&e, &ref, d, -1))
+        return false;
+
+    for (int i = 0; i < c->moveCount; i++)
+    {
+        Move valid[MAX_MOVES], m;
+        int count = ListMoves(&e, &ref, i, valid);
+        if (i % sweepEvery == 0 && !SameMoves(&e, valid, count, d, i))
+            return false;
+        if (!DecodeMove(valid, count, c->moves[i], &m))
+            continue;
+
+        int refSteps, refDestroyed[MAX_REF_STEPS];
+        int expected = RefStep(&ref, m, &refSteps, refDestroyed);
+        ArenaReset(&scratch->arena);
+        StepResult result;
+        int got = EngineStep(&e, m, &scratch->arena, &result);
+        if (movesPlayed != NULL)
+            (*movesPlayed)++;
+
+        d->move = i;
+        if (got != expected)
+        {
+            snprintf(d->what, sizeof(d->what), "(%d,%d)-(%d,%d) puanı: motor %d, referans %d",
+                m.fromRow, m.fromCol, m.toRow, m.toCol, got, expected);
+            return false;
+        }
+        if (got >= 0 && result.stepCount != refSteps)
+        {
+            snprintf(d->what, sizeof(d->what), "kaskad adımı: motor %d, referans %d", result.stepCount, refSteps);
+            return false;
+        }
+        int k = 0;
+        for (const CascadeStep *s = result.steps; s != NULL && !result.truncated && k < MAX_REF_STEPS; s = s->next, k++)
+        {
+            if (s->destroyed != refDestroyed[k])
+            {
+                snprintf(d->what, sizeof(d->what), "kaskad adımı %d patlayan: motor %d, referans %d", k + 1, s->destroyed, refDestroyed[k]);
+                return false;
+            }
+        }
+        if (!SameBoard(&e, &ref, d, i))
+            return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// İndirgeme
+
+static bool StillFails(const FuzzCase *c, Scratch *scratch, Divergence *d)
+{
+    Divergence local;
+    if (RunCase(c, scratch, &local, NULL))
+        return false;
+    *d = local;
+    return true;
+}
+
+// Durgun tahta: hazır eşleşme yok (motorun IsValidSwap ön koşulu)
+static bool IsResting(const int8_t board[ROWS][COLS])
+{
+    RefBoard b;
+    memset(&b, 0, sizeof(b));
+    memcpy(b.type, board, sizeof(b.type));
+    return !RefMarkMatches(&b);
+}
+
+// 1) ayrışmadan sonraki hamleleri at, 2) öncekileri tek tek çıkarmayı dene,
+// 3) ayrışan hamleden hemen önceki tahtayı yakala, tek hamlelik vakaya çevir,
+// 4) tahtadaki şekerleri küçük türlere indirip sadeleştir
+static void Minimize(FuzzCase *c, Scratch *scratch, Divergence *d)
+{
+    if (d->move >= 0)
+        c->moveCount = d->move + 1;
+
+    for (int i = c->moveCount - 2; i >= 0; i--)
+    {
+        FuzzCase shorter = *c;
+        memmove(&shorter.moves[i], &shorter.moves[i + 1], (size_t)(shorter.moveCount - i - 1));
+        shorter.moveCount--;
+        Divergence sd;
+        if (StillFails(&shorter, scratch, &sd) && sd.move >= 0)
+        {
+            shorter.moveCount = sd.move + 1;
+            *c = shorter;
+            *d = sd;
+            i = c->moveCount - 1;
+        }
+    }
+
+    if (d->move > 0 && !c->explicitBoard)
+    {
+        // Ayrışan hamleye kadar oynat, o anki tahtayla tek hamlelik vaka kur
+        Engine e;
+        RefBoard ref;
+        Setup(c, &e, &ref);
+        Move valid[MAX_MOVES], m;
+        for (int i = 0; i < d->move; i++)
+        {
+            int steps, destroyed[MAX_REF_STEPS];
+            if (DecodeMove(valid, ListMoves(&e, &ref, i, valid), c->moves[i], &m))
+            {
+                RefStep(&ref, m, &steps, destroyed);
+                EngineStep(&e, m, NULL, NULL);
+            }
+        }
+        FuzzCase single = *c;
+        single.explicitBoard = true;
+        memcpy(single.board, ref.type, sizeof(single.board));
+        single.rngState = ref.rngState;
+        single.moveCount = 0;
+        if (DecodeMove(valid, ListMoves(&e, &ref, d->move, valid), c->moves[d->move], &m))
+            single.moves[single.moveCount++] = EncodeMove(m);
+        Divergence sd;
+        if (StillFails(&single, scratch, &sd))
+        {
+            *c = single;
+            *d = sd;
+        }
+    }
+
+    if (!c->explicitBoard)
+        return;
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int cell = 0; cell < ROWS * COLS; cell++)
+        {
+            int r = cell / COLS, col = cell % COLS;
+            for (int8_t type = 0; type < c->board[r][col]; type++)
+            {
+                FuzzCase simpler = *c;
+                simpler.board[r][col] = type;
+                Divergence sd;
+                if (IsResting(simpler.board) && StillFails(&simpler, scratch, &sd))
+                {
+                    *c = simpler;
+                    *d = sd;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void PrintCase(const FuzzCase *c, const Divergence *d)
+{
+    fprintf(stderr, "AYRIŞMA: %s (hamle %d)\n", d->what, d->move);
+    if (c->explicitBoard)
+    {
+        fprintf(stderr, "tahta (üreteç durumu %016llx):\n", (unsigned long long)c->rngState);
+        for (int r = 0; r < ROWS; r++)
+        {
+            fprintf(stderr, "  ");
+            for (int col = 0; col < COLS; col++)
+                fprintf(stderr, "%d", c->board[r][col]);
+            fprintf(stderr, "\n");
+        }
+    }
+    else
+    {
+        fprintf(stderr, "tohum %llu\n", (unsigned long long)c->seed);
+    }
+    fprintf(stderr, "hamleler (%d):", c->moveCount);
+    for (int i = 0; i < c->moveCount; i++)
+        fprintf(stderr, " %02x", c->moves[i]);
+    fprintf(stderr, "\n");
+}
+
+static void InitScratch(Scratch *scratch)
+{
+    ArenaInit(&scratch->arena, scratch->memory, sizeof(scratch->memory));
+}
+
+#ifdef DIFFFUZZ_LIBFUZZER
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static Scratch scratch;
+    static bool ready = false;
+    if (!ready)
+    {
+        InitScratch(&scratch);
+        ready = true;
+    }
+    if (size < sizeof(uint64_t))
+        return 0;
+
+    FuzzCase c;
+    memset(&c, 0, sizeof(c));
+    memcpy(&c.seed, data, sizeof(c.seed));
+    c.moveCount = (int)(size - sizeof(c.seed) < MAX_CASE_MOVES ? size - sizeof(c.seed) : MAX_CASE_MOVES);
+    memcpy(c.moves, data + sizeof(c.seed), (size_t)c.moveCount);
+
+    Divergence d;
+    if (!RunCase(&c, &scratch, &d, NULL))
+    {
+        Minimize(&c, &scratch, &d);
+        PrintCase(&c, &d);
+        abort();
+    }
+    return 0;
+}
+
+#else
+
+static long long caseCount = 100000;
+static int movesPerCase = 64;
+static int threadCount = 0;
+static uint64_t baseSeed = 1;
+
+static atomic_llong nextCase = 0;
+static atomic_bool diverged = false;
+static mtx_t reportLock;
+
+typedef struct
+{
+    Scratch scratch;
+    long long cases, moves;
+} FuzzThread;
+
+static uint64_t Mix(uint64_t a, uint64_t b)
+{
+    uint64_t z = a ^ (b + 0x9E3779B97F4A7C15ull + (a << 6) + (a >> 2));
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Vakanın hamleleri tohumdan; çoğu geçerli hamle, bir kısmı ham (geçersiz olabilir)
+static void MakeCase(FuzzCase *c, long long index)
+{
+    memset(c, 0, sizeof(*c));
+    c->seed = Mix(baseSeed, (uint64_t)index);
+    c->moveCount = movesPerCase;
+    uint64_t rng = c->seed;
+    for (int i = 0; i < c->moveCount; i++)
+    {
+        rng = Mix(rng, (uint64_t)i);
+        c->moves[i] = (rng & 3) ? (uint8_t)(rng >> 8 & 0x7F) : (uint8_t)(0x80 | (rng >> 8 & 0x7F));
+    }
+}
+
+static int FuzzThreadMain(void *arg)
+{
+    FuzzThread *t = arg;
+    InitScratch(&t->scratch);
+    while (!atomic_load_explicit(&diverged, memory_order_relaxed))
+    {
+        long long first = atomic_fetch_add(&nextCase, CASES_PER_CLAIM);
+        if (first >= caseCount)
+            break;
+        long long last = first + CASES_PER_CLAIM < caseCount ? first + CASES_PER_CLAIM : caseCount;
+        for (long long i = first; i < last; i++)
+        {
+            FuzzCase c;
+            Divergence d;
+            MakeCase(&c, i);
+            t->cases++;
+            if (!RunCase(&c, &t->scratch, &d, &t->moves))
+            {
+                // İlk bulan raporlar, diğerleri durur
+                if (!atomic_exchange(&diverged, true))
+                {
+                    mtx_lock(&reportLock);
+                    fprintf(stderr, "vaka %lld ayrıştı, indirgeniyor...\n", i);
+                    Minimize(&c, &t->scratch, &d);
+                    PrintCase(&c, &d);
+                    mtx_unlock(&reportLock);
+                }
+                return 0;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (strcmp(argv[i], "--cases") == 0)
+            caseCount = atoll(argv[i + 1]);
+        else if (strcmp(argv[i], "--moves") == 0)
+            movesPerCase = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--threads") == 0)
+            threadCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--sweep-every") == 0)
+            sweepEvery = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0)
+            baseSeed = strtoull(argv[i + 1], NULL, 10);
+    }
+    if (threadCount <= 0)
+        threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threadCount > MAX_THREADS)
+        threadCount = MAX_THREADS;
+    if (movesPerCase < 1 || movesPerCase > MAX_CASE_MOVES || caseCount < 1 || sweepEvery < 1)
+    {
+        fprintf(stderr, "--moves 1..%d, --cases >= 1 ve --sweep-every >= 1 olmalı\n", MAX_CASE_MOVES);
+        return 1;
+    }
+
+    mtx_init(&reportLock, mtx_plain);
+    static FuzzThread threads[MAX_THREADS];
+    thrd_t handles[MAX_THREADS];
+    struct timespec start, end;
+    timespec_get(&start, TIME_UTC);
+    for (int i = 0; i < threadCount; i++)
+        thrd_create(&handles[i], FuzzThreadMain, &threads[i]);
+
+    long long cases = 0, moves = 0;
+    for (int i = 0; i < threadCount; i++)
+    {
+        thrd_join(handles[i], NULL);
+        cases += threads[i].cases;
+        moves += threads[i].moves;
+    }
+    timespec_get(&end, TIME_UTC);
+    double elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+    printf("%lld vaka, %lld hamle, %d iş parçacığı, %.1f s (%.0f hamle/s)\n", cases, moves, threadCount,
+        elapsed, (double)moves / elapsed);
+    mtx_destroy(&reportLock);
+    return atomic_load(&diverged) ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,752 @@
+#include "engine.h"
+#include "eventbus.h"
+#include <stdlib.h>
+#include <string.h>
+
+void EngineSeed(Engine *e, uint64_t seed)
+{
+    // splitmix64 ile karıştır, xorshift için durum asla 0 olmasın
+    uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    e->rngState = z ? z : 0x9E3779B97F4A7C15ull;
+}
+
+// xorshift64*: küçük, hızlı ve durumu tek bir sayı
+uint64_t EngineRandom(Engine *e)
+{
+    e->rngState ^= e->rngState >> 12;
+    e->rngState ^= e->rngState << 25;
+    e->rngState ^= e->rngState >> 27;
+    return e->rngState * 0x2545F4914F6CDD1Dull;
+}
+
+int EngineRandomCandy(Engine *e)
+{
+    return (int)((EngineRandom(e) >> 32) % CANDY_TYPES);
+}
+
+void EngineInit(Engine *e, uint64_t seed)
+{
+    memset(e, 0, sizeof(*e));
+    e->comboMultiplier = 1;
+    EngineSeed(e, seed);
+    EngineLoadLevel(e, NULL);
+    EngineFillNoMatches(e);
+}
+
+static int Feeder(const Engine *e, int cell, const int16_t *portalFrom)
+{
+    if (portalFrom[cell] >= 0)
+        return portalFrom[cell];
+    int r = cell / MAX_COLS, c = cell % MAX_COLS;
+    int above = cell - MAX_COLS;
+    // Geçit girişi düz aşağıyı beslemez, şekerleri çıkışa gönderir
+    if (r > 0 && e->kind[r - 1][c] == CELL_PLAYABLE && portalFrom[MAX_CELLS + above] < 0)
+        return above;
+    return -1;
+}
+
+// Besleyici bağlarını izleyerek zincirleri kur; sütun sırası korunur ki
+// dikdörtgen tahtada yeni şekerler eskisiyle aynı sırayla üretilsin
+static bool BuildGravity(Engine *e, const int16_t *portalFrom)
+{
+    GravityGraph *g = &e->gravity;
+    bool feeds[MAX_CELLS] = { false };
+    bool visited[MAX_CELLS] = { false };
+    for (int cell = 0; cell < MAX_CELLS; cell++)
+    {
+        if (e->kind[cell / MAX_COLS][cell % MAX_COLS] != CELL_PLAYABLE)
+            continue;
+        int f = Feeder(e, cell, portalFrom);
+        if (f >= 0)
+            feeds[f] = true;
+    }
+
+    g->chainCount = 0;
+    int used = 0;
+    for (int c = 0; c < e->cols; c++)
+    {
+        for (int r = e->rows - 1; r >= 0; r--)
+        {
+            int cell = r * MAX_COLS + c;
+            if (e->kind[r][c] != CELL_PLAYABLE || feeds[cell])
+                continue;
+            int k = g->chainCount++;
+            g->chainStart[k] = (uint8_t)used;
+            int top = cell;
+            for (int at = cell; at >= 0; at = Feeder(e, at, portalFrom))
+            {
+                if (visited[at])
+                    return false;
+                visited[at] = true;
+                g->cells[used++] = (uint8_t)at;
+                g->chainOf[at] = (uint8_t)k;
+                top = at;
+            }
+
+            // Üstünde sadece delik varsa tepe yeni şeker alır, yoksa çaprazdan kayarak dolar
+            int tr = top / MAX_COLS, tc = top % MAX_COLS;
+            bool open = true;
+            for (int rr = 0; rr < tr; rr++)
+                if (e->kind[rr][tc] != CELL_HOLE)
+                    open = false;
+            g->slide[k][0] = g->slide[k][1] = -1;
+            if (!open && tr > 0)
+            {
+                if (tc > 0 && e->kind[tr - 1][tc - 1] == CELL_PLAYABLE)
+                    g->slide[k][0] = (int16_t)(top - MAX_COLS - 1);
+                if (tc < e->cols - 1 && e->kind[tr - 1][tc + 1] == CELL_PLAYABLE)
+                    g->slide[k][1] = (int16_t)(top - MAX_COLS + 1);
+            }
+            g->spawns[k] = open || (g->slide[k][0] < 0 && g->slide[k][1] < 0);
+        }
+    }
+    g->chainStart[g->chainCount] = (uint8_t)used;
+
+    // Ziyaret edilmeyen oynanabilir hücre = tabanı olmayan geçit döngüsü
+    for (int r = 0; r < e->rows; r++)
+        for (int c = 0; c < e->cols; c++)
+            if (e->kind[r][c] == CELL_PLAYABLE && !visited[r * MAX_COLS + c])
+                return false;
+    return true;
+}
+
+static bool Playable(const Engine *e, int r, int c)
+{
+    return r >= 0 && r < e->rows && c >= 0 && c < e->cols && e->kind[r][c] == CELL_PLAYABLE;
+}
+
+// Bir hamle için en az 3'lü oynanabilir dizi ve ona takasla şeker getirecek bir komşu gerekir
+static bool HasMoveShape(const Engine *e)
+{
+    for (int r = 0; r < e->rows; r++)
+    {
+        for (int c = 0; c < e->cols; c++)
+        {
+            for (int dir = 0; dir < 2; dir++)
+            {
+                int dr = dir, dc = 1 - dir;
+                if (!Playable(e, r, c) || !Playable(e, r + dr, c + dc) || !Playable(e, r + 2 * dr, c + 2 * dc))
+                    continue;
+                if (Playable(e, r - dr, c - dc) || Playable(e, r + 3 * dr, c + 3 * dc))
+                    return true;
+                for (int k = 0; k < 3; k++)
+                    if (Playable(e, r + k * dr + dc, c + k * dc + dr) || Playable(e, r + k * dr - dc, c + k * dc - dr))
+                        return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool EngineLoadLevel(Engine *e, const char *layout)
+{
+    // portalFrom[cell]: çıkışı besleyen giriş; portalFrom[MAX_CELLS + cell]: girişin çıkışı
+    int16_t portalFrom[2 * MAX_CELLS];
+    int16_t entrance[MAX_PORTALS], exit[MAX_PORTALS];
+    for (int i = 0; i < 2 * MAX_CELLS; i++)
+        portalFrom[i] = -1;
+    for (int i = 0; i < MAX_PORTALS; i++)
+        entrance[i] = exit[i] = -1;
+
+    memset(e->kind, CELL_HOLE, sizeof(e->kind));
+    memset(e->jelly, 0, sizeof(e->jelly));
+    memset(e->type, BLOCKED_CELL, sizeof(e->type));
+    memset(e->marked, 0, sizeof(e->marked));
+    memset(e->fall, 0, sizeof(e->fall));
+    e->jellyLeft = 0;
+    e->moveLimit = 0;
+    e->levelState = LEVEL_PLAYING;
+
+    if (layout == NULL)
+    {
+        e->rows = ROWS;
+        e->cols = COLS;
+        for (int r = 0; r < ROWS; r++)
+            for (int c = 0; c < COLS; c++)
+                e->kind[r][c] = CELL_PLAYABLE;
+        e->jellyGoal = 0;
+        return BuildGravity(e, portalFrom);
+    }
+
+    int rows = 0, cols = 0, c = 0;
+    for (const char *p = layout; *p != '\0'; p++)
+    {
+        if (*p == '\r')
+            continue;
+        if (*p == '\n')
+        {
+            if (c > 0)
+                rows++;
+            c = 0;
+            continue;
+        }
+        if (c == 0 && strncmp(p, "moves", 5) == 0)
+        {
+            e->moveLimit = atoi(p + 5);
+            while (p[1] != '\0' && p[1] != '\n')
+                p++;
+            continue;
+        }
+        if (rows >= MAX_ROWS || c >= MAX_COLS)
+            return false;
+        int cell = rows * MAX_COLS + c;
+        char ch = *p;
+        if (ch == '#' || ch == ' ')
+            e->kind[rows][c] = CELL_HOLE;
+        else if (ch == 'X')
+            e->kind[rows][c] = CELL_BLOCKER;
+        else if (ch == '.' || ch == 'J' || (ch >= 'a' && ch < 'a' + MAX_PORTALS) || (ch >= 'A' && ch < 'A' + MAX_PORTALS))
+        {
+            e->kind[rows][c] = CELL_PLAYABLE;
+            if (ch == 'J')
+            {
+                e->jelly[rows][c] = 1;
+                e->jellyLeft++;
+            }
+            else if (ch >= 'a' && ch < 'a' + MAX_PORTALS)
+            {
+                if (entrance[ch - 'a'] >= 0)
+                    return false;
+                entrance[ch - 'a'] = (int16_t)cell;
+            }
+            else if (ch >= 'A' && ch < 'A' + MAX_PORTALS)
+            {
+                if (exit[ch - 'A'] >= 0)
+                    return false;
+                exit[ch - 'A'] = (int16_t)cell;
+            }
+        }
+        else
+            return false;
+        c++;
+        if (c > cols)
+            cols = c;
+    }
+    if (c > 0)
+        rows++;
+    if (rows == 0 || cols == 0)
+        return false;
+    e->rows = rows;
+    e->cols = cols;
+    e->jellyGoal = e->jellyLeft;
+
+    for (int i = 0; i < MAX_PORTALS; i++)
+    {
+        if ((entrance[i] >= 0) != (exit[i] >= 0))
+            return false;
+        if (entrance[i] >= 0)
+        {
+            portalFrom[exit[i]] = entrance[i];
+            portalFrom[MAX_CELLS + entrance[i]] = exit[i];
+        }
+    }
+    return BuildGravity(e, portalFrom) && HasMoveShape(e);
+}
+
+bool EngineIsAdjacent(Move m)
+{
+    return (abs(m.fromRow - m.toRow) == 1 && m.fromCol == m.toCol) ||
+        (abs(m.fromCol - m.toCol) == 1 && m.fromRow == m.toRow);
+}
+
+void EngineSwap(Engine *e, Move m)
+{
+    int8_t type = e->type[m.fromRow][m.fromCol];
+    e->type[m.fromRow][m.fromCol] = e->type[m.toRow][m.toCol];
+    e->type[m.toRow][m.toCol] = type;
+    bool marked = e->marked[m.fromRow][m.fromCol];
+    e->marked[m.fromRow][m.fromCol] = e->marked[m.toRow][m.toCol];
+    e->marked[m.toRow][m.toCol] = marked;
+}
+
+void EngineResetMarks(Engine *e)
+{
+    memset(e->marked, 0, sizeof(e->marked));
+}
+
+// Eşleşme kontrolü ve işaretleme; önceki işaretler silinmez, şekersiz hücreler atlanır
+bool EngineMarkMatches(Engine *e)
+{
+    bool found = false;
+    // Satır kontrolü
+    for (int r = 0; r < e->rows; r++)
+    {
+        int count = 1;
+        for (int c = 1; c < e->cols; c++)
+        {
+            if (e->type[r][c] >= 0 && e->type[r][c] == e->type[r][c - 1])
+                count++;
+            else
+                count = 1;
+            if (count >= 3)
+            {
+                found = true;
+                for (int k = 0; k < count; k++)
+                    e->marked[r][c - k] = true;
+            }
+        }
+    }
+    // Sütun kontrolü
+    for (int c = 0; c < e->cols; c++)
+    {
+        int count = 1;
+        for (int r = 1; r < e->rows; r++)
+        {
+            if (e->type[r][c] >= 0 && e->type[r][c] == e->type[r - 1][c])
+                count++;
+            else
+                count = 1;
+            if (count >= 3)
+            {
+                found = true;
+                for (int k = 0; k < count; k++)
+                    e->marked[r - k][c] = true;
+            }
+        }
+    }
+    return found;
+}
+
+// Patlayanları boşalt, kaç şeker gittiğini döndür
+int EngineDestroyMarked(Engine *e)
+{
+    if (e->events != NULL)
+    {
+        MatchList matches;
+        EngineFindMatches(e, &matches);
+        for (int i = 0; i < matches.count; i++)
+            EventBusClaim(e->events, EVENT_MATCH)->match = matches.groups[i];
+    }
+
+    int destroyed = 0;
+    for (int r = 0; r < e->rows; r++)
+    {
+        for (int c = 0; c < e->cols; c++)
+        {
+            if (e->marked[r][c] && e->kind[r][c] == CELL_PLAYABLE)
+            {
+                destroyed++;
+                e->type[r][c] = EMPTY_CELL;
+                if (e->jelly[r][c] > 0)
+                {
+                    e->jelly[r][c]--;
+                    e->jellyLeft--;
+                }
+            }
+        }
+    }
+    return destroyed;
+}
+
+// Zinciri alttan üste sıkıştır; taşınan şeker işaretini de götürür, boşalan hücrenin işareti kalır
+static void CompactChain(Engine *e, int k)
+{
+    const GravityGraph *g = &e->gravity;
+    int8_t *type = &e->type[0][0];
+    bool *marked = &e->marked[0][0];
+    int8_t *fall = &e->fall[0][0];
+    int write = g->chainStart[k];
+    for (int read = g->chainStart[k]; read < g->chainStart[k + 1]; read++)
+    {
+        int from = g->cells[read];
+        if (type[from] == EMPTY_CELL)
+            continue;
+        if (read != write)
+        {
+            int to = g->cells[write];
+            type[to] = type[from];
+            marked[to] = marked[from];
+            fall[to] = (int8_t)(read - write);
+            type[from] = EMPTY_CELL;
+        }
+        write++;
+    }
+}
+
+// Zincirin tepesinde boş kalanlara yukarıdan aşağı yeni şeker
+static void RefillChain(Engine *e, int k)
+{
+    const GravityGraph *g = &e->gravity;
+    int8_t *type = &e->type[0][0];
+    int8_t *fall = &e->fall[0][0];
+    int end = g->chainStart[k + 1];
+    for (int i = end - 1; i >= g->chainStart[k]; i--)
+    {
+        int cell = g->cells[i];
+        if (type[cell] == EMPTY_CELL)
+        {
+            type[cell] = (int8_t)EngineRandomCandy(e);
+            fall[cell] = (int8_t)(end - i);
+        }
+    }
+}
+
+// Engel altındaki zincirleri çapraz komşulardan kaydırarak doldur. Her kayma bir
+// şekeri aşağı indirir, bu yüzden döngü biter; dikdörtgen tahtada hiç çalışmaz.
+static void SlideCandies(Engine *e)
+{
+    const GravityGraph *g = &e->gravity;
+    int8_t *type = &e->type[0][0];
+    bool *marked = &e->marked[0][0];
+    int8_t *fall = &e->fall[0][0];
+    bool moved = true;
+    while (moved)
+    {
+        moved = false;
+        for (int k = 0; k < g->chainCount; k++)
+        {
+            if (g->spawns[k])
+                continue;
+            int top = g->cells[g->chainStart[k + 1] - 1];
+            while (type[top] == EMPTY_CELL)
+            {
+                int from = -1;
+                for (int i = 0; i < 2 && from < 0; i++)
+                    if (g->slide[k][i] >= 0 && type[g->slide[k][i]] >= 0)
+                        from = g->slide[k][i];
+                if (from < 0)
+                    break;
+                type[top] = type[from];
+                marked[top] = marked[from];
+                fall[top] = 1;
+                type[from] = EMPTY_CELL;
+                CompactChain(e, k);
+                int source = g->chainOf[from];
+                CompactChain(e, source);
+                if (g->spawns[source])
+                    RefillChain(e, source);
+                moved = true;
+            }
+        }
+    }
+}
+
+// Düşürme ve doldurma; fall[][] animasyon için kaç hücre düşüldüğünü tutar.
+// Zincirler seviye yüklenirken kurulduğu için arama yok, her zincir tek geçiş.
+void EngineDropCandies(Engine *e)
+{
+    memset(e->fall, 0, sizeof(e->fall));
+    for (int k = 0; k < e->gravity.chainCount; k++)
+        CompactChain(e, k);
+    for (int k = 0; k < e->gravity.chainCount; k++)
+        if (e->gravity.spawns[k])
+            RefillChain(e, k);
+    SlideCandies(e);
+}
+
+// Skor hesaplama
+void EngineAddScore(Engine *e, int destroyed)
+{
+    int before = e->score;
+    if (destroyed == 3)
+        e->score += 60 * e->comboMultiplier;
+    else if (destroyed == 4)
+        e->score += 100 * e->comboMultiplier;
+    else if (destroyed >= 5)
+        e->score += 200 * e->comboMultiplier;
+
+    if (e->events != NULL)
+    {
+        GameEvent *ev = EventBusClaim(e->events, EVENT_CASCADE_STEP);
+        ev->cascade.step = e->comboMultiplier;
+        ev->cascade.destroyed = destroyed;
+        ev->cascade.scoreGained = e->score - before;
+        EventBusPublish(e->events);
+    }
+}
+
+void EngineEmitSwap(Engine *e, Move m)
+{
+    if (e->events == NULL)
+        return;
+    EventBusClaim(e->events, EVENT_SWAP)->swap = m;
+    EventBusPublish(e->events);
+}
+
+static LevelState EndLevel(Engine *e, LevelState state)
+{
+    e->levelState = state;
+    if (e->events != NULL)
+    {
+        GameEvent *ev = EventBusClaim(e->events, e->levelState == LEVEL_WON ? EVENT_LEVEL_WON : EVENT_LEVEL_LOST);
+        ev->level.score = e->score;
+        ev->level.moves = e->moves;
+        EventBusPublish(e->events);
+    }
+    return e->levelState;
+}
+
+LevelState EngineCheckLevelEnd(Engine *e)
+{
+    if (e->levelState != LEVEL_PLAYING)
+        return e->levelState;
+    if (e->jellyGoal > 0 && e->jellyLeft == 0)
+        return EndLevel(e, LEVEL_WON);
+    if (e->moveLimit > 0 && e->moves >= e->moveLimit)
+        return EndLevel(e, LEVEL_LOST);
+    return LEVEL_PLAYING;
+}
+
+// Hücre, aynı türden en az 3'lük yatay ya da dikey dizinin parçası mı?
+static bool MatchesAt(const Engine *e, int r, int c)
+{
+    int8_t type = e->type[r][c];
+    if (type < 0)
+        return false;
+    int left = c, right = c;
+    while (left > 0 && e->type[r][left - 1] == type)
+        left--;
+    while (right < e->cols - 1 && e->type[r][right + 1] == type)
+        right++;
+    if (right - left >= 2)
+        return true;
+    int top = r, bottom = r;
+    while (top > 0 && e->type[top - 1][c] == type)
+        top--;
+    while (bottom < e->rows - 1 && e->type[bottom + 1][c] == type)
+        bottom++;
+    return bottom - top >= 2;
+}
+
+// Swap sonrası eşleşme var mı kontrolü. Tahtada hazır eşleşme yokken yeni
+// eşleşme ancak yer değiştiren iki hücreden geçebilir, tüm tahtayı taramaya gerek yok.
+bool EngineIsValidSwap(Engine *e, Move m)
+{
+    int8_t a = e->type[m.fromRow][m.fromCol];
+    int8_t b = e->type[m.toRow][m.toCol];
+    if (a < 0 || b < 0 || a == b)
+        return false;
+    e->type[m.fromRow][m.fromCol] = b;
+    e->type[m.toRow][m.toCol] = a;
+    bool valid = MatchesAt(e, m.fromRow, m.fromCol) || MatchesAt(e, m.toRow, m.toCol);
+    e->type[m.fromRow][m.fromCol] = a;
+    e->type[m.toRow][m.toCol] = b;
+    return valid;
+}
+
+// Oynanabilir hamle var mı?
+bool EngineHasValidMove(Engine *e)
+{
+    for (int r = 0; r < e->rows; r++)
+    {
+        for (int c = 0; c < e->cols; c++)
+        {
+            // Sağ ile swap
+            if (c < e->cols - 1 && EngineIsValidSwap(e, (Move){ r, c, r, c + 1 }))
+                return true;
+            // Aşağı ile swap
+            if (r < e->rows - 1 && EngineIsValidSwap(e, (Move){ r, c, r + 1, c }))
+                return true;
+        }
+    }
+    return false;
+}
+
+// Tahtayı rastgele doldur, başlangıçta eşleşme olmasın
+bool EngineFillNoMatches(Engine *e)
+{
+    bool dealt = false;
+    for (int attempt = 0; attempt < MAX_FILL_ATTEMPTS && !dealt; attempt++)
+    {
+        for (int r = 0; r < e->rows; r++)
+            for (int c = 0; c < e->cols; c++)
+                e->type[r][c] = e->kind[r][c] == CELL_PLAYABLE ? (int8_t)EngineRandomCandy(e) : BLOCKED_CELL;
+        EngineResetMarks(e);
+        EngineMarkMatches(e);
+        dealt = !EngineMarkMatches(e) && EngineHasValidMove(e);
+    }
+    EngineResetMarks(e);
+    memset(e->fall, 0, sizeof(e->fall));
+    return dealt;
+}
+
+// Tüm geçerli hamleleri sabit kapasiteli listeye yaz
+int EngineGenerateMoves(Engine *e, MoveList *out)
+{
+    out->count = 0;
+    for (int r = 0; r < e->rows; r++)
+    {
+        for (int c = 0; c < e->cols; c++)
+        {
+            Move right = { (int8_t)r, (int8_t)c, (int8_t)r, (int8_t)(c + 1) };
+            Move down = { (int8_t)r, (int8_t)c, (int8_t)(r + 1), (int8_t)c };
+            if (c < e->cols - 1 && EngineIsValidSwap(e, right))
+                out->moves[out->count++] = right;
+            if (r < e->rows - 1 && EngineIsValidSwap(e, down))
+                out->moves[out->count++] = down;
+        }
+    }
+    return out->count;
+}
+
+static bool GroupContains(const MatchGroup *g, int r, int c)
+{
+    for (int i = 0; i < g->count; i++)
+        if (g->row[i] == r && g->col[i] == c)
+            return true;
+    return false;
+}
+
+// Diziyi kesiştiği aynı türden gruba ekle (sığıyorsa), yoksa yeni grup aç
+static void AddRun(MatchList *out, int8_t type, int r, int c, int dr, int dc, int length)
+{
+    for (int g = 0; g < out->count; g++)
+    {
+        MatchGroup *group = &out->groups[g];
+        if (group->type != type)
+            continue;
+        int shared = 0;
+        for (int k = 0; k < length; k++)
+            if (GroupContains(group, r + k * dr, c + k * dc))
+                shared++;
+        if (shared == 0 || group->count + length - shared > MAX_GROUP_CELLS)
+            continue;
+        for (int k = 0; k < length; k++)
+        {
+            if (!GroupContains(group, r + k * dr, c + k * dc))
+            {
+                group->row[group->count] = (int8_t)(r + k * dr);
+                group->col[group->count] = (int8_t)(c + k * dc);
+                group->count++;
+            }
+        }
+        if (group->shape != MATCH_LINE5)
+            group->shape = length >= 5 ? MATCH_LINE5 : MATCH_LT;
+        return;
+    }
+
+    if (out->count >= MAX_MATCH_GROUPS)
+        return;
+    MatchGroup *group = &out->groups[out->count++];
+    group->type = type;
+    group->count = (int8_t)length;
+    group->shape = length >= 5 ? MATCH_LINE5 : (length == 4 ? MATCH_LINE4 : MATCH_LINE3);
+    for (int k = 0; k < length; k++)
+    {
+        group->row[k] = (int8_t)(r + k * dr);
+        group->col[k] = (int8_t)(c + k * dc);
+    }
+}
+
+// Eşleşen dizileri şekilleriyle grupla (işaretlere dokunmaz)
+void EngineFindMatches(const Engine *e, MatchList *out)
+{
+    out->count = 0;
+    for (int r = 0; r < e->rows; r++)
+    {
+        int start = 0;
+        for (int c = 1; c <= e->cols; c++)
+        {
+            if (c < e->cols && e->type[r][c] == e->type[r][start])
+                continue;
+            if (c - start >= 3 && e->type[r][start] >= 0)
+                AddRun(out, e->type[r][start], r, start, 0, 1, c - start);
+            start = c;
+        }
+    }
+    for (int c = 0; c < e->cols; c++)
+    {
+        int start = 0;
+        for (int r = 1; r <= e->rows; r++)
+        {
+            if (r < e->rows && e->type[r][c] == e->type[start][c])
+                continue;
+            if (r - start >= 3 && e->type[start][c] >= 0)
+                AddRun(out, e->type[start][c], start, c, 1, 0, r - start);
+            start = r;
+        }
+    }
+}
+
+// Bu adımda patlayacakları ve grupları arenaya kaydet; sığmazsa NULL
+static CascadeStep *RecordStep(const Engine *e, Arena *arena)
+{
+    CascadeStep *step = ArenaAlloc(arena, sizeof(CascadeStep));
+    if (step == NULL)
+        return NULL;
+    memset(step, 0, sizeof(*step));
+    for (int r = 0; r < e->rows; r++)
+        for (int c = 0; c < e->cols; c++)
+            if (e->marked[r][c])
+                step->destroyedMask[(r * MAX_COLS + c) / 64] |= 1ull << ((r * MAX_COLS + c) % 64);
+
+    MatchList matches;
+    EngineFindMatches(e, &matches);
+    if (matches.count > 0)
+    {
+        step->groups = ArenaAlloc(arena, sizeof(MatchGroup) * (size_t)matches.count);
+        if (step->groups == NULL)
+            return NULL;
+        memcpy(step->groups, matches.groups, sizeof(MatchGroup) * (size_t)matches.count);
+        step->groupCount = matches.count;
+    }
+    return step;
+}
+
+int EngineStep(Engine *e, Move m, Arena *arena, StepResult *out)
+{
+    StepResult ignored;
+    if (out == NULL)
+        out = &ignored;
+    memset(out, 0, sizeof(*out));
+    out->scoreGained = -1;
+
+    if (m.fromRow < 0 || m.fromRow >= e->rows || m.fromCol < 0 || m.fromCol >= e->cols ||
+        m.toRow < 0 || m.toRow >= e->rows || m.toCol < 0 || m.toCol >= e->cols)
+        return -1;
+    if (e->levelState != LEVEL_PLAYING || !EngineIsAdjacent(m) || !EngineIsValidSwap(e, m))
+        return -1;
+
+    int before = e->score;
+    EngineSwap(e, m);
+    EngineEmitSwap(e, m);
+    e->moves++;
+    e->comboMultiplier = 1;
+    CascadeStep **tail = &out->steps;
+    while (EngineMarkMatches(e))
+    {
+        CascadeStep *step = NULL;
+        if (arena != NULL)
+        {
+            step = RecordStep(e, arena);
+            out->truncated |= step == NULL;
+        }
+        int scoreBefore = e->score;
+        int destroyed = EngineDestroyMarked(e);
+        EngineAddScore(e, destroyed);
+        EngineDropCandies(e);
+        if (step != NULL)
+        {
+            step->destroyed = destroyed;
+            step->scoreGained = e->score - scoreBefore;
+            step->comboMultiplier = e->comboMultiplier;
+            memcpy(step->fall, e->fall, sizeof(step->fall));
+            *tail = step;
+            tail = &step->next;
+        }
+        e->comboMultiplier++;
+        out->stepCount++;
+    }
+    EngineResetMarks(e);
+    e->comboMultiplier = 1;
+
+    // Oynanabilir hamle yoksa tahtayı yeniden doldur
+    if (!EngineHasValidMove(e))
+    {
+        out->reshuffled = true;
+        // Yükleyici hamlesiz düzenleri reddeder; yine de dağıtılamazsa oyun kilitlenmesin
+        if (!EngineFillNoMatches(e))
+            EndLevel(e, LEVEL_LOST);
+    }
+    EngineCheckLevelEnd(e);
+    out->scoreGained = e->score - before;
+    return out->scoreGained;
+}
+
+int EngineApplyMove(Engine *e, Move m)
+{
+    return EngineStep(e, m, NULL, NULL);
+}
@@ -0,0 +1,177 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+// Grafikten bağımsız oyun motoru: her tahta kendi durumunu ve rastgele
+// üretecini taşır, böylece oyun, sunucu ve araçlar aynı kuralları paylaşır.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "arena.h"
+
+#define ROWS 8 // Varsayılan dikdörtgen tahta
+#define COLS 8
+#define MAX_ROWS 12 // Seviye düzenleri için üst sınır
+#define MAX_COLS 12
+#define MAX_CELLS (MAX_ROWS * MAX_COLS)
+#define CANDY_TYPES 6
+#define EMPTY_CELL -1
+#define BLOCKED_CELL -2 // Delik ya da engel: şeker yok, hiçbir şeyle eşleşmez
+#define MAX_MOVES (2 * MAX_CELLS)
+#define MAX_GROUP_CELLS (MAX_ROWS + MAX_COLS)
+#define MAX_MATCH_GROUPS (MAX_ROWS * (MAX_COLS / 3) + MAX_COLS * (MAX_ROWS / 3))
+#define CELL_MASK_WORDS ((MAX_CELLS + 63) / 64)
+#define MAX_PORTALS 8
+#define MAX_FILL_ATTEMPTS 1000 // EngineFillNoMatches bu kadar dağıtımda başaramazsa vazgeçer
+
+// Bir hamle: (fromRow, fromCol) hücresini (toRow, toCol) ile değiştir
+typedef struct
+{
+    int8_t fromRow, fromCol;
+    int8_t toRow, toCol;
+} Move;
+
+struct EventBus;
+
+typedef enum
+{
+    LEVEL_PLAYING,
+    LEVEL_WON, // Tüm jöle temizlendi
+    LEVEL_LOST // Hamle sınırı doldu
+} LevelState;
+
+typedef enum
+{
+    CELL_PLAYABLE,
+    CELL_HOLE,   // Tahtada yok, şekerler içinden geçemez
+    CELL_BLOCKER // Hareketsiz engel
+} CellKind;
+
+// Seviye yüklenirken bir kez kurulan yerçekimi grafiği. Her oynanabilir hücrenin
+// tek bir besleyicisi var (üstteki hücre ya da geçit girişi), bu yüzden hücreler
+// alttan üste zincirlere ayrılır ve düşürme her zincirde tek doğrusal geçiştir.
+// Hücre numarası: row * MAX_COLS + col
+typedef struct
+{
+    int chainCount;
+    uint8_t chainStart[MAX_CELLS + 1]; // Zincir k: cells[chainStart[k] .. chainStart[k + 1])
+    uint8_t cells[MAX_CELLS];          // Alttan üste
+    uint8_t chainOf[MAX_CELLS];
+    bool spawns[MAX_CELLS];            // Zincir başına: tepesi yeni şekerle dolar
+    int16_t slide[MAX_CELLS][2];       // Zincir başına: tepesine çapraz kayabilecek hücreler, -1 = yok
+} GravityGraph;
+
+typedef struct
+{
+    int8_t type[MAX_ROWS][MAX_COLS];  // EMPTY_CELL = boş, BLOCKED_CELL = şeker olamaz
+    bool marked[MAX_ROWS][MAX_COLS];  // Patlamak üzere işaretli (düşerken şekerle birlikte taşınır)
+    int8_t fall[MAX_ROWS][MAX_COLS];  // Son düşürmede buraya gelen şekerin düştüğü hücre sayısı
+    uint8_t kind[MAX_ROWS][MAX_COLS]; // CellKind
+    uint8_t jelly[MAX_ROWS][MAX_COLS]; // Kalan jöle katmanı, üstündeki şeker patlayınca azalır
+    int rows, cols;
+    int jellyLeft;
+    int jellyGoal; // Seviye başındaki jöle, 0 = jöle hedefi yok
+    int moveLimit; // 0 = sınırsız
+    LevelState levelState;
+    GravityGraph gravity;
+    struct EventBus *events; // NULL değilse motor olayları buraya yayınlar
+    uint64_t rngState;
+    int score;
+    int moves;
+    int comboMultiplier;
+} Engine;
+
+typedef enum
+{
+    MATCH_LINE3,
+    MATCH_LINE4,
+    MATCH_LINE5,
+    MATCH_LT // Kesişen yatay ve dikey diziler (L/T)
+} MatchShape;
+
+// Sabit kapasiteli küçük vektörler: yığında durur, sıcak yolda hiç ayırma yapılmaz
+typedef struct
+{
+    MatchShape shape;
+    int8_t type;
+    int8_t count;
+    int8_t row[MAX_GROUP_CELLS];
+    int8_t col[MAX_GROUP_CELLS];
+} MatchGroup;
+
+typedef struct
+{
+    int count;
+    MatchGroup groups[MAX_MATCH_GROUPS];
+} MatchList;
+
+typedef struct
+{
+    int count;
+    Move moves[MAX_MOVES];
+} MoveList;
+
+// Kaskadın bir adımının farkı; arenadan ayrılır ve bağlı liste olarak tutulur
+typedef struct CascadeStep
+{
+    uint64_t destroyedMask[CELL_MASK_WORDS]; // bit (row * MAX_COLS + col)
+    int destroyed;
+    int scoreGained;
+    int comboMultiplier;
+    int groupCount;
+    MatchGroup *groups;
+    int8_t fall[MAX_ROWS][MAX_COLS];
+    struct CascadeStep *next;
+} CascadeStep;
+
+typedef struct
+{
+    int scoreGained; // -1 = geçersiz hamle
+    int stepCount;
+    bool reshuffled;
+    bool truncated; // Arena doldu, bazı adımların farkı kaydedilmedi
+    CascadeStep *steps;
+} StepResult;
+
+// Yeni tahta: üreteci tohumla ve varsayılan ROWS x COLS düzene eşleşmesiz, oynanabilir bir tahta dağıt
+void EngineInit(Engine *e, uint64_t seed);
+// Seviye düzeni, satır başına bir metin satırı:
+//   '.' şeker, 'J' jöleli şeker, '#' ya da ' ' delik, 'X' engel,
+//   'a'-'h' geçit girişi, 'A'-'H' aynı harfli girişten düşenleri alan çıkış.
+// "moves 25" satırı hamle sınırı koyar.
+// NULL = dolu ROWS x COLS. Tahtayı dağıtmaz (ardından EngineFillNoMatches);
+// boyut aşımı, eşsiz geçit, döngü ya da hiç hamle yapılamayacak düzen
+// (yanında takas edilecek hücre olan 3'lü oynanabilir dizi yok) varsa false döner.
+bool EngineLoadLevel(Engine *e, const char *layout);
+void EngineSeed(Engine *e, uint64_t seed);
+uint64_t EngineRandom(Engine *e);
+int EngineRandomCandy(Engine *e);
+
+bool EngineIsAdjacent(Move m);
+void EngineSwap(Engine *e, Move m);
+void EngineResetMarks(Engine *e);
+bool EngineMarkMatches(Engine *e);
+// Patlatmadan önce eşleşme gruplarını olay olarak ayırır (EngineAddScore ile yayınlanır)
+int EngineDestroyMarked(Engine *e);
+void EngineDropCandies(Engine *e);
+// Adımın puanını ekler; olay yayını açıksa adımın partisini (eşleşmeler + adım) kapatır
+void EngineAddScore(Engine *e, int destroyed);
+// Dinlenmiş tahta (hazır eşleşme yok) varsayılır; sadece değişen iki hücreye bakar
+bool EngineIsValidSwap(Engine *e, Move m);
+bool EngineHasValidMove(Engine *e);
+// Eşleşmesiz ve en az bir hamlesi olan tahta dağıtır; MAX_FILL_ATTEMPTS denemede
+// bulamazsa false (tahta son denemede kalır, çağıran başka düzene geçmeli)
+bool EngineFillNoMatches(Engine *e);
+
+void EngineFindMatches(const Engine *e, MatchList *out);
+void EngineEmitSwap(Engine *e, Move m);
+// Kaskad bittikten sonra çağrılır; sonuç ilk belli olduğunda kazanma/kaybetme olayı yayınlanır
+LevelState EngineCheckLevelEnd(Engine *e);
+int EngineGenerateMoves(Engine *e, MoveList *out);
+
+// Hamleyi doğrula ve kaskad bitene kadar uygula (animasyonsuz).
+// Geçersizse tahta değişmez ve -1 döner, aksi halde kazanılan puan.
+// arena verilirse her kaskad adımının farkı out->steps'e yazılır; heap kullanılmaz.
+int EngineStep(Engine *e, Move m, Arena *arena, StepResult *out);
+int EngineApplyMove(Engine *e, Move m);
+
+#endif
@@ -0,0 +1,86 @@
+#include "eventbus.h"
+#include <string.h>
+
+#define EVENT_MASK (EVENT_BUS_SIZE - 1)
+
+void EventBusInit(EventBus *bus)
+{
+    memset(bus, 0, sizeof(*bus));
+    atomic_init(&bus->head, 0);
+    for (int i = 0; i < EVENT_BUS_SIZE; i++)
+        atomic_init(&bus->slots[i].seq, 0);
+}
+
+// Yuva sıra kilidi (seqlock) gibi yazılır: önce 0, sonra olay, en son sıra numarası
+GameEvent *EventBusClaim(EventBus *bus, GameEventType type)
+{
+    if (bus->claimed - atomic_load_explicit(&bus->head, memory_order_relaxed) >= EVENT_BATCH_MAX)
+        EventBusPublish(bus);
+    EventSlot *slot = &bus->slots[bus->claimed & EVENT_MASK];
+    bus->claimed++;
+    atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memset(&slot->event, 0, sizeof(slot->event));
+    slot->event.type = type;
+    slot->event.batch = bus->batch;
+    return &slot->event;
+}
+
+void EventBusPublish(EventBus *bus)
+{
+    uint64_t head = atomic_load_explicit(&bus->head, memory_order_relaxed);
+    if (head == bus->claimed)
+        return;
+    for (uint64_t n = head; n < bus->claimed; n++)
+        atomic_store_explicit(&bus->slots[n & EVENT_MASK].seq, n + 1, memory_order_release);
+    atomic_store_explicit(&bus->head, bus->claimed, memory_order_release);
+    bus->batch++;
+}
+
+void EventCursorInit(const EventBus *bus, EventCursor *cursor)
+{
+    cursor->next = atomic_load_explicit(&bus->head, memory_order_acquire);
+    cursor->dropped = 0;
+}
+
+// Üreticinin yazıyor olabileceği yuvalar dışında kalan en eski olay
+static uint64_t OldestSafe(uint64_t head)
+{
+    return head + EVENT_BATCH_MAX > EVENT_BUS_SIZE ? head + EVENT_BATCH_MAX - EVENT_BUS_SIZE : 0;
+}
+
+int EventBusPoll(const EventBus *bus, EventCursor *cursor, GameEvent *out, int max)
+{
+    uint64_t head = atomic_load_explicit(&bus->head, memory_order_acquire);
+    int count = 0;
+    while (count < max && cursor->next < head)
+    {
+        uint64_t oldest = OldestSafe(head);
+        if (cursor->next < oldest)
+        {
+            cursor->dropped += oldest - cursor->next;
+            cursor->next = oldest;
+            continue;
+        }
+
+        const EventSlot *slot = &bus->slots[cursor->next & EVENT_MASK];
+        uint64_t before = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        out[count] = slot->event;
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t after = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+        if (before != cursor->next + 1 || after != before)
+        {
+            // Okurken üzerine yazıldı: başı yeniden oku ve güvenli bölgeye atla
+            head = atomic_load_explicit(&bus->head, memory_order_acquire);
+            if (cursor->next >= OldestSafe(head))
+            {
+                cursor->dropped++;
+                cursor->next++;
+            }
+            continue;
+        }
+        cursor->next++;
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,84 @@
+#ifndef EVENTBUS_H
+#define EVENTBUS_H
+
+// Oyun olayları için sınırlı, kilitsiz tek üretici / çok tüketicili halka.
+// Üretici (motor) asla beklemez: yavaş tüketicinin okumadığı olayların üzerine yazılır,
+// tüketici bunu sıra numarasından anlar, kaçırdıklarını sayar ve en eski geçerli olaydan devam eder.
+// Her tüketicinin kendi imleci var, halkayı istediği sıklıkta okur.
+
+#include <stdatomic.h>
+#include "engine.h"
+
+#define EVENT_BUS_SIZE 256     // 2'nin kuvveti olmalı
+#define EVENT_BATCH_MAX 64     // Yayınlanmamış en fazla olay, dolunca parti erken yayınlanır
+
+typedef enum
+{
+    EVENT_SWAP,
+    EVENT_MATCH,
+    EVENT_SPECIAL_CREATED,   // Özel şekerler eklendiğinde yayınlanacak, şimdilik üretilmiyor
+    EVENT_SPECIAL_ACTIVATED,
+    EVENT_CASCADE_STEP,      // Adımın eşleşmelerinden sonra gelir ve partiyi kapatır
+    EVENT_LEVEL_WON,
+    EVENT_LEVEL_LOST
+} GameEventType;
+
+typedef struct
+{
+    GameEventType type;
+    uint32_t batch; // Aynı partide yayınlanan olaylar aynı numarayı taşır
+    union
+    {
+        Move swap;
+        MatchGroup match;
+        struct
+        {
+            int8_t row, col;
+            uint8_t kind;
+        } special;
+        struct
+        {
+            int step; // 1 = hamlenin ilk patlaması
+            int destroyed;
+            int scoreGained;
+        } cascade;
+        struct
+        {
+            int score;
+            int moves;
+        } level;
+    };
+} GameEvent;
+
+typedef struct
+{
+    atomic_uint_fast64_t seq; // Yuvadaki olayın sıra numarası + 1, 0 = yazılıyor
+    GameEvent event;
+} EventSlot;
+
+typedef struct EventBus
+{
+    EventSlot slots[EVENT_BUS_SIZE];
+    _Alignas(64) atomic_uint_fast64_t head; // Yayınlanmış olay sayısı
+    uint64_t claimed; // Sadece üretici
+    uint32_t batch;   // Sadece üretici
+} EventBus;
+
+typedef struct
+{
+    uint64_t next;
+    uint64_t dropped; // Üretici tarafından üzerine yazıldığı için kaçırılan olaylar
+} EventCursor;
+
+void EventBusInit(EventBus *bus);
+
+// Üretici: yuva ayır ve doldur; EventBusPublish'e kadar tüketiciler görmez
+GameEvent *EventBusClaim(EventBus *bus, GameEventType type);
+void EventBusPublish(EventBus *bus);
+
+// Tüketici: imleç şu andan itibaren okumaya başlar
+void EventCursorInit(const EventBus *bus, EventCursor *cursor);
+// En fazla max olay kopyalar, kopyalanan sayıyı döner
+int EventBusPoll(const EventBus *bus, EventCursor *cursor, GameEvent *out, int max);
+
+#endif
@@ -1,18 +1,51 @@
 #include "raylib.h"
+#include "engine.h"
+#include "metrics.h"
+#include "eventbus.h"
+#include "particles.h"
+#include "boardbank.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
 #include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
 #include <math.h>
+#include <threads.h>
+#include <stdatomic.h>
 
-#define ROWS 8
-#define COLS 8
-#define CANDY_TYPES 6
 #define CELL_SIZE 64
 #define BOARD_OFFSET_X 100
 #define BOARD_OFFSET_Y 100
 #define ANIMATION_SPEED 12.0f
 #define DESTROY_ANIMATION_SPEED 0.15f
+#define TICK_RATE 60 // Mantık adımı/saniye, animasyon hızları bu hıza göre ayarlı
+#define TICK_DT (1.0 / TICK_RATE)
+#define MAX_TICKS_PER_UPDATE 8 // Çok geride kalınca yakalamaya çalışma
+#define FAST_FORWARD_SPEED 4
+#define INPUT_QUEUE_SIZE 64 // 2'nin kuvveti olmalı
+#define PENDING_INPUT_MAX 16 // Çizimin henüz ölçmediği uygulanmış olaylar; taşarsa en eskisi düşer
+#define MAX_TOUCH_POINTS 10
+#define SAVE_FILE "savegame.bin"
+#define SAVE_TEMP_FILE "savegame.tmp"
+#define SAVE_MAGIC 0x56534343u // "CCSV"
+#define SAVE_VERSION 2
+#define PARTICLE_BENCH_COUNT 50000
+#define MAX_SCORE_POPUPS 16
+#define EVENTS_PER_POLL 32
+#define TELEMETRY_POLL_FRAMES 30 // Telemetri olayları yarım saniyede bir toplanır
+#define BOARD_BANK_FILE "boards.bin" // boardgen çıktısı; yoksa tahtalar çalışırken üretilir
+#define START_BOARD_TIER 1 // 0 = en kolay
+#define METRICS_FILE "metrics.jsonl"
+#define METRICS_FLUSH_SECONDS 10.0
+#define METRICS_MAX_BYTES (1L << 20)
+
+#ifdef _WIN32
+// windows.h raylib ile çakışıyor, sadece gereken fonksiyonu bildir
+__declspec(dllimport) int __stdcall MoveFileExA(const char *existingName, const char *newName, unsigned long flags);
+#define MOVEFILE_REPLACE_EXISTING 0x1
+#endif
 
 typedef enum
 {
@@ -24,12 +57,11 @@ typedef enum
     CANDY_ORANGE
 } CandyType;
 
+// Hücredeki şekerin animasyon durumu; tür ve işaretler motorda (game) tutulur
 typedef struct
 {
-    CandyType type;
     bool isMoving;
     float yOffset; // Animasyon için
-    bool isMarkedToDestroy;
     float scale; // Patlama animasyonu için
 } Candy;
 
@@ -39,32 +71,153 @@ typedef struct
     bool selected;
 } Cell;
 
-Candy board[ROWS][COLS];
-int score = 0;
+Engine game;
+Candy board[MAX_ROWS][MAX_COLS];
 Cell selectedCell = { -1, -1, false };
 bool isSwapping = false;
+Cell swapSource = { -1, -1, false };
 Cell swapTarget = { -1, -1, false };
 bool isAnimating = false;
 bool isDestroying = false;
 bool comboActive = false;
-int comboMultiplier = 1;
+uint32_t levelHash = 0; // Seviye düzeni metninin özeti, varsayılan tahtada 0
+BoardBank boardBank;
+const BoardBankEntry *startBoards = NULL; // Bu seviyenin bankı, yoksa NULL
+
+// Sürümlü ikili kayıt; tek fread ile geri okunur, ayrıştırma yok
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size; // sizeof(SaveState), farklı derlemeleri ayırt etmek için
+    uint32_t levelHash; // Kayıt sadece aynı seviye düzeniyle geri yüklenir
+    int8_t type[MAX_ROWS][MAX_COLS];
+    uint8_t jelly[MAX_ROWS][MAX_COLS];
+    uint64_t rngState;
+    int32_t score;
+    int32_t moves;
+    uint32_t checksum; // Önceki alanların FNV-1a özeti
+} SaveState;
+
+typedef enum
+{
+    SOUND_SWAP,
+    SOUND_MATCH,
+    SOUND_WIN,
+    SOUND_LOSE,
+    SOUND_COUNT
+} GameSound;
+
+typedef struct
+{
+    Vector2 position;
+    int points;
+    float life;
+} ScorePopup;
+
+// Uygulanmış bir giriş olayı ve toplandığı an (gecikme ölçümü için)
+typedef struct
+{
+    unsigned int seq;
+    double time;
+} InputStamp;
+
+// Çizim iş parçacığına yayınlanan değişmez tahta görüntüsü
+typedef struct
+{
+    int8_t type[MAX_ROWS][MAX_COLS];
+    uint8_t jelly[MAX_ROWS][MAX_COLS];
+    float yOffset[MAX_ROWS][MAX_COLS];
+    float scale[MAX_ROWS][MAX_COLS];
+    int jellyLeft;
+    int movesLeft; // Hamle sınırı yoksa -1
+    LevelState levelState;
+    Cell selectedCell;
+    int score;
+    bool comboActive;
+    int comboMultiplier;
+    unsigned long long tick;
+    double time; // Yayınlandığı an (GetTime)
+    InputStamp inputs[PENDING_INPUT_MAX]; // Etkisi bu görüntüde görünen, henüz ölçülmemiş olaylar
+    int inputCount;
+} BoardSnapshot;
+
+// Zaman damgalı giriş olayları (çizim iş parçacığı üretir, simülasyon tüketir)
+typedef enum
+{
+    INPUT_POINTER_DOWN,
+    INPUT_TOUCH_DOWN
+} InputEventType;
+
+typedef struct
+{
+    InputEventType type;
+    int pointerId;
+    int row, col;
+    double time; // GetTime(), olayın toplandığı an
+    unsigned int seq;
+} InputEvent;
+
+// Kilitsiz üçlü tampon: motor "back"e yazar, çizim "front"u okur, "middle" atomik takas edilir
+#define SNAPSHOT_FRESH 4
+BoardSnapshot snapshots[3];
+atomic_int snapshotMiddle = 1;
+int snapshotBack = 0;  // Sadece simülasyon iş parçacığı
+int snapshotFront = 2; // Sadece çizim iş parçacığı
+
+// İş parçacıkları arası paylaşılan durum
+atomic_bool simRunning = true;
+atomic_int simSpeed = 1;      // Hızlı ileri sarmada yayın başına adım sayısı
+
+// Tek üretici/tek tüketici giriş kuyruğu
+InputEvent inputQueue[INPUT_QUEUE_SIZE];
+atomic_uint inputHead = 0; // Sadece çizim iş parçacığı yazar
+atomic_uint inputTail = 0; // Sadece simülasyon iş parçacığı yazar
+
+// Simülasyon tarafı giriş durumu
+bool hasQueuedSwap = false; // Kaskad sırasında sıraya alınan hamle
+Cell queuedSwapSource, queuedSwapTarget;
+InputStamp pendingInputs[PENDING_INPUT_MAX]; // Uygulanmış, çizimin henüz ölçmediği olaylar (sıralı)
+int pendingInputCount = 0;
+atomic_uint measuredInputSeq = 0; // Çizim tarafı gecikmesini kaydettiği son olayı yazar
+
+// Motor olayları: simülasyon yayınlar, çizim tarafındaki tüketiciler kendi hızında okur
+EventBus gameEvents;
+EventCursor audioEvents, particleEvents, popupEvents, telemetryEvents;
+
+// Ses efektleri (dosya yoksa sessiz devam edilir)
+const char *soundFiles[SOUND_COUNT] = { "assets/swap.wav", "assets/match.wav", "assets/win.wav", "assets/lose.wav" };
+Sound sounds[SOUND_COUNT];
+bool soundLoaded[SOUND_COUNT] = { false };
+
+ParticlePool particles; // Çizim iş parçacığına ait
+ScorePopup popups[MAX_SCORE_POPUPS];
 
 // Renkler (yedek olarak saklanıyor)
 Color candyColors[CANDY_TYPES];
 
 // Doku/Görseller
+const char *candyFiles[CANDY_TYPES] = {
+    "assets/candy_red.png", "assets/candy_green.png", "assets/candy_blue.png",
+    "assets/candy_yellow.png", "assets/candy_purple.png", "assets/candy_orange.png"
+};
 Texture2D candyTextures[CANDY_TYPES];
 bool useTextures = false; // Dokuların başarıyla yüklenip yüklenmediğini kontrol için
 
 // Yardımcı fonksiyonlar
+Move CellMove(Cell a, Cell b)
+{
+    return (Move){ (int8_t)a.row, (int8_t)a.col, (int8_t)b.row, (int8_t)b.col };
+}
+
 bool IsAdjacent(Cell a, Cell b)
 {
-    return (abs(a.row - b.row) == 1 && a.col == b.col) ||
-        (abs(a.col - b.col) == 1 && a.row == b.row);
+    return EngineIsAdjacent(CellMove(a, b));
 }
 
 void SwapCandies(Cell a, Cell b)
 {
+    EngineSwap(&game, CellMove(a, b));
     Candy temp = board[a.row][a.col];
     board[a.row][a.col] = board[b.row][b.col];
     board[b.row][b.col] = temp;
@@ -72,120 +225,51 @@ void SwapCandies(Cell a, Cell b)
 
 void ResetDestroyFlags()
 {
-    for (int r = 0; r < ROWS; r++)
-        for (int c = 0; c < COLS; c++)
-            board[r][c].isMarkedToDestroy = false;
+    EngineResetMarks(&game);
 }
 
 void ResetMovingFlags()
 {
-    for (int r = 0; r < ROWS; r++)
-        for (int c = 0; c < COLS; c++)
+    for (int r = 0; r < game.rows; r++)
+        for (int c = 0; c < game.cols; c++)
             board[r][c].isMoving = false;
 }
 
 void ResetScales()
 {
-    for (int r = 0; r < ROWS; r++)
-        for (int c = 0; c < COLS; c++)
+    for (int r = 0; r < game.rows; r++)
+        for (int c = 0; c < game.cols; c++)
             board[r][c].scale = 1.0f;
 }
 
 // Eşleşme kontrolü ve işaretleme
 bool MarkMatches()
 {
-    bool found = false;
-    // Satır kontrolü
-    for (int r = 0; r < ROWS; r++)
-    {
-        int count = 1;
-        for (int c = 1; c < COLS; c++)
-        {
-            if (board[r][c].type == board[r][c - 1].type)
-                count++;
-            else
-                count = 1;
-            if (count >= 3)
-            {
-                found = true;
-                for (int k = 0; k < count; k++)
-                    board[r][c - k].isMarkedToDestroy = true;
-            }
-        }
-    }
-    // Sütun kontrolü
-    for (int c = 0; c < COLS; c++)
-    {
-        int count = 1;
-        for (int r = 1; r < ROWS; r++)
-        {
-            if (board[r][c].type == board[r - 1][c].type)
-                count++;
-            else
-                count = 1;
-            if (count >= 3)
-            {
-                found = true;
-                for (int k = 0; k < count; k++)
-                    board[r - k][c].isMarkedToDestroy = true;
-            }
-        }
-    }
-    return found;
+    return EngineMarkMatches(&game);
 }
 
-// Patlayanları yok et ve skor ekle
+// Patlayanları yok et
 int DestroyMarkedCandies()
 {
-    int destroyed = 0;
-    for (int r = 0; r < ROWS; r++)
-    {
-        for (int c = 0; c < COLS; c++)
-        {
-            if (board[r][c].isMarkedToDestroy)
-            {
-                destroyed++;
-                board[r][c].type = -1; // Boş
+    for (int r = 0; r < game.rows; r++)
+        for (int c = 0; c < game.cols; c++)
+            if (game.marked[r][c])
                 board[r][c].scale = 0.0f;
-            }
-        }
-    }
-    return destroyed;
+    return EngineDestroyMarked(&game);
 }
 
-// Düşürme ve doldurma
+// Düşürme ve doldurma; düşen ve yeni gelen şekerler yukarıdan kayarak gelir
 void DropCandies()
 {
-    for (int c = 0; c < COLS; c++)
+    EngineDropCandies(&game);
+    for (int r = 0; r < game.rows; r++)
     {
-        for (int r = ROWS - 1; r >= 0; r--)
+        for (int c = 0; c < game.cols; c++)
         {
-            if (board[r][c].type == -1)
+            if (game.fall[r][c] > 0)
             {
-                // Yukarıdan ilk dolu şekeri bul
-                int rr = r - 1;
-                while (rr >= 0 && board[rr][c].type == -1)
-                    rr--;
-                if (rr >= 0)
-                {
-                    board[r][c] = board[rr][c];
-                    board[r][c].isMoving = true;
-                    board[r][c].yOffset = (float)((rr - r) * CELL_SIZE);
-                    board[rr][c].type = -1;
-                }
-            }
-        }
-    }
-    // En üstte boş kalanlara yeni şeker
-    for (int c = 0; c < COLS; c++)
-    {
-        for (int r = 0; r < ROWS; r++)
-        {
-            if (board[r][c].type == -1)
-            {
-                board[r][c].type = GetRandomValue(0, CANDY_TYPES - 1);
                 board[r][c].isMoving = true;
-                board[r][c].yOffset = -((float)CELL_SIZE * (float)(r + 1));
+                board[r][c].yOffset = -((float)CELL_SIZE * (float)game.fall[r][c]);
                 board[r][c].scale = 1.0f;
             }
         }
@@ -196,9 +280,9 @@ void DropCandies()
 bool UpdateAnimations()
 {
     bool animating = false;
-    for (int r = 0; r < ROWS; r++)
+    for (int r = 0; r < game.rows; r++)
     {
-        for (int c = 0; c < COLS; c++)
+        for (int c = 0; c < game.cols; c++)
         {
             if (board[r][c].isMoving)
             {
@@ -229,7 +313,7 @@ bool UpdateAnimations()
                     }
                 }
             }
-            if (board[r][c].isMarkedToDestroy && board[r][c].scale > 0.0f)
+            if (game.marked[r][c] && board[r][c].scale > 0.0f)
             {
                 board[r][c].scale -= DESTROY_ANIMATION_SPEED;
                 if (board[r][c].scale < 0.0f)
@@ -244,102 +328,223 @@ bool UpdateAnimations()
 // Swap sonrası eşleşme var mı kontrolü
 bool IsValidSwap(Cell a, Cell b)
 {
-    SwapCandies(a, b);
-    bool valid = MarkMatches();
-    SwapCandies(a, b);
-    ResetDestroyFlags();
-    return valid;
+    return EngineIsValidSwap(&game, CellMove(a, b));
 }
 
 // Oynanabilir hamle var mı?
 bool HasValidMove()
 {
-    for (int r = 0; r < ROWS; r++)
+    return EngineHasValidMove(&game);
+}
+
+// Tahtayı doldur, başlangıçta eşleşme olmasın; hazır bank varsa oradan sabit sürede
+void FillBoardNoMatches()
+{
+    if (!BoardBankDeal(&boardBank, startBoards, &game) && !EngineFillNoMatches(&game))
     {
-        for (int c = 0; c < COLS; c++)
+        TraceLog(LOG_WARNING, "Düzende hamlesi olan tahta dağıtılamadı, varsayılan tahta kullanılıyor.");
+        EngineLoadLevel(&game, NULL);
+        levelHash = 0;
+        startBoards = NULL;
+        EngineFillNoMatches(&game);
+    }
+    for (int r = 0; r < game.rows; r++)
+    {
+        for (int c = 0; c < game.cols; c++)
         {
-            Cell a = { r, c, false };
-            Cell b;
-            // Sağ ile swap
-            if (c < COLS - 1)
-            {
-                b = (Cell){ r, c + 1, false };
-                if (IsValidSwap(a, b))
-                    return true;
-            }
-            // Aşağı ile swap
-            if (r < ROWS - 1)
-            {
-                b = (Cell){ r + 1, c, false };
-                if (IsValidSwap(a, b))
-                    return true;
-            }
+            board[r][c].isMoving = false;
+            board[r][c].yOffset = 0.0f;
+            board[r][c].scale = 1.0f;
         }
     }
-    return false;
 }
 
-// Tahtayı rastgele doldur, başlangıçta eşleşme olmasın
-void FillBoardNoMatches()
+// Skor hesaplama
+void AddScore(int destroyed)
+{
+    EngineAddScore(&game, destroyed);
+}
+
+uint32_t SaveChecksum(const SaveState *save)
 {
-    do
+    const unsigned char *bytes = (const unsigned char *)save;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(SaveState, checksum); i++)
+        hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+// Oturmuş tahtayı kaydet: önce geçici dosyaya yaz, sonra atomik olarak yerine taşı.
+// fsync yapılmaz; bekçi yeniden başlatmasında işletim sistemi önbelleği yeterli.
+bool SaveGame()
+{
+    SaveState save;
+    memset(&save, 0, sizeof(save));
+    save.magic = SAVE_MAGIC;
+    save.version = SAVE_VERSION;
+    save.size = (uint16_t)sizeof(SaveState);
+    save.levelHash = levelHash;
+    memcpy(save.type, game.type, sizeof(save.type));
+    memcpy(save.jelly, game.jelly, sizeof(save.jelly));
+    save.rngState = game.rngState;
+    save.score = game.score;
+    save.moves = game.moves;
+    save.checksum = SaveChecksum(&save);
+
+    FILE *file = fopen(SAVE_TEMP_FILE, "wb");
+    if (file == NULL)
+        return false;
+    bool written = fwrite(&save, sizeof(save), 1, file) == 1;
+    written = (fclose(file) == 0) && written;
+    if (!written)
+        return false;
+#ifdef _WIN32
+    return MoveFileExA(SAVE_TEMP_FILE, SAVE_FILE, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(SAVE_TEMP_FILE, SAVE_FILE) == 0;
+#endif
+}
+
+// Kayıt varsa ve geçerliyse tahtayı olduğu gibi geri yükle
+bool LoadGame()
+{
+    SaveState save;
+    FILE *file = fopen(SAVE_FILE, "rb");
+    if (file == NULL)
+        return false;
+    bool read = fread(&save, sizeof(save), 1, file) == 1;
+    fclose(file);
+    if (!read || save.magic != SAVE_MAGIC || save.version != SAVE_VERSION ||
+        save.size != sizeof(SaveState) || save.checksum != SaveChecksum(&save) || save.levelHash != levelHash)
+    {
+        TraceLog(LOG_WARNING, "Kayıt dosyası geçersiz, yeni oyun başlatılıyor.");
+        return false;
+    }
+    for (int r = 0; r < game.rows; r++)
     {
-        for (int r = 0; r < ROWS; r++)
+        for (int c = 0; c < game.cols; c++)
         {
-            for (int c = 0; c < COLS; c++)
-            {
-                board[r][c].type = GetRandomValue(0, CANDY_TYPES - 1);
-                board[r][c].isMoving = false;
-                board[r][c].yOffset = 0.0f;
-                board[r][c].isMarkedToDestroy = false;
-                board[r][c].scale = 1.0f;
-            }
+            bool playable = game.kind[r][c] == CELL_PLAYABLE;
+            if (playable ? (save.type[r][c] < 0 || save.type[r][c] >= CANDY_TYPES) : save.type[r][c] != BLOCKED_CELL)
+                return false;
         }
-        ResetDestroyFlags();
-        MarkMatches();
-    } while (MarkMatches() || !HasValidMove());
-    ResetDestroyFlags();
+    }
+
+    for (int r = 0; r < game.rows; r++)
+    {
+        for (int c = 0; c < game.cols; c++)
+        {
+            game.type[r][c] = save.type[r][c];
+            board[r][c].isMoving = false;
+            board[r][c].yOffset = 0.0f;
+            board[r][c].scale = 1.0f;
+        }
+    }
+    memcpy(game.jelly, save.jelly, sizeof(game.jelly));
+    game.jellyLeft = 0;
+    for (int r = 0; r < game.rows; r++)
+        for (int c = 0; c < game.cols; c++)
+            game.jellyLeft += game.jelly[r][c];
+    EngineResetMarks(&game);
+    game.rngState = save.rngState;
+    game.score = save.score;
+    game.moves = save.moves;
+    return true;
 }
 
-// Skor hesaplama
-void AddScore(int destroyed)
+// Simülasyonun son durumunu üçlü tampona yayınla
+void PublishSnapshot(unsigned long long tick)
 {
-    if (destroyed == 3)
-        score += 60 * comboMultiplier;
-    else if (destroyed == 4)
-        score += 100 * comboMultiplier;
-    else if (destroyed >= 5)
-        score += 200 * comboMultiplier;
+    BoardSnapshot *s = &snapshots[snapshotBack];
+    for (int r = 0; r < game.rows; r++)
+    {
+        for (int c = 0; c < game.cols; c++)
+        {
+            s->type[r][c] = game.type[r][c];
+            s->jelly[r][c] = game.jelly[r][c];
+            s->yOffset[r][c] = board[r][c].yOffset;
+            s->scale[r][c] = board[r][c].scale;
+        }
+    }
+    s->selectedCell = selectedCell;
+    s->score = game.score;
+    s->jellyLeft = game.jellyLeft;
+    s->movesLeft = game.moveLimit > 0 ? game.moveLimit - game.moves : -1;
+    s->levelState = game.levelState;
+    s->comboActive = comboActive;
+    s->comboMultiplier = game.comboMultiplier;
+    s->tick = tick;
+    s->time = GetTime();
+    // Birkaç görüntü tek karede atlanabilir; her olay çizim ölçene kadar taşınır
+    unsigned int measured = atomic_load_explicit(&measuredInputSeq, memory_order_acquire);
+    int kept = 0;
+    for (int i = 0; i < pendingInputCount; i++)
+        if ((int)(pendingInputs[i].seq - measured) > 0)
+            pendingInputs[kept++] = pendingInputs[i];
+    pendingInputCount = kept;
+    memcpy(s->inputs, pendingInputs, sizeof(InputStamp) * (size_t)kept);
+    s->inputCount = kept;
+    snapshotBack = atomic_exchange_explicit(&snapshotMiddle, snapshotBack | SNAPSHOT_FRESH, memory_order_acq_rel) & ~SNAPSHOT_FRESH;
 }
 
-// Çizim
-void DrawBoard()
+// Yeni görüntü varsa "front" ile takas et; eskisi "previous"a kopyalanır
+bool AcquireSnapshot(BoardSnapshot *previous)
 {
-    for (int r = 0; r < ROWS; r++)
+    if (!(atomic_load_explicit(&snapshotMiddle, memory_order_acquire) & SNAPSHOT_FRESH))
+        return false;
+    *previous = snapshots[snapshotFront];
+    snapshotFront = atomic_exchange_explicit(&snapshotMiddle, snapshotFront, memory_order_acq_rel) & ~SNAPSHOT_FRESH;
+    return true;
+}
+
+// Çizim: iki görüntü arasında alpha oranında ara değer alır
+void DrawBoard(const BoardSnapshot *prev, const BoardSnapshot *cur, float alpha)
+{
+    for (int r = 0; r < game.rows; r++)
     {
-        for (int c = 0; c < COLS; c++)
+        for (int c = 0; c < game.cols; c++)
         {
+            int type = cur->type[r][c];
+            float yOffset = cur->yOffset[r][c];
+            float scale = cur->scale[r][c];
+            if (prev->type[r][c] == type)
+            {
+                // Aynı şeker iki adımda da buradaysa hareketi yumuşat
+                yOffset = prev->yOffset[r][c] + (yOffset - prev->yOffset[r][c]) * alpha;
+                scale = prev->scale[r][c] + (scale - prev->scale[r][c]) * alpha;
+            }
             int x = BOARD_OFFSET_X + c * CELL_SIZE;
-            int y = BOARD_OFFSET_Y + r * CELL_SIZE + (int)board[r][c].yOffset;
-            float scale = board[r][c].scale;
+            int y = BOARD_OFFSET_Y + r * CELL_SIZE + (int)yOffset;
 
-            if (board[r][c].type >= 0)
+            // Delikler boş kalır, engel ve jöle hücreye sabit çizilir
+            // (kind seviye yüklendikten sonra değişmez, çizimden okunabilir)
+            if (game.kind[r][c] == CELL_HOLE)
+                continue;
+            if (game.kind[r][c] == CELL_BLOCKER)
+            {
+                DrawRectangle(x, BOARD_OFFSET_Y + r * CELL_SIZE, CELL_SIZE, CELL_SIZE, DARKGRAY);
+                continue;
+            }
+            if (cur->jelly[r][c] > 0)
+                DrawRectangle(x + 2, BOARD_OFFSET_Y + r * CELL_SIZE + 2, CELL_SIZE - 4, CELL_SIZE - 4, Fade(PINK, 0.4f));
+
+            if (type >= 0)
             {
                 // Arka plan çerçevesi
                 DrawRectangleLinesEx((Rectangle) { (float)x, (float)y, (float)CELL_SIZE, (float)CELL_SIZE }, 1, LIGHTGRAY);
 
-                if (useTextures && board[r][c].type < CANDY_TYPES)
+                if (useTextures && type < CANDY_TYPES)
                 {
                     // Dokular varsa doku ile çiz
                     float textureScale = scale * 0.9f; // Texture biraz daha küçük olsun
-                    Rectangle sourceRect = { 0, 0, (float)candyTextures[board[r][c].type].width, (float)candyTextures[board[r][c].type].height };
+                    Rectangle sourceRect = { 0, 0, (float)candyTextures[type].width, (float)candyTextures[type].height };
                     Rectangle destRect = {
                         (float)x + (CELL_SIZE * (1.0f - textureScale) / 2.0f),
                         (float)y + (CELL_SIZE * (1.0f - textureScale) / 2.0f),
                         CELL_SIZE * textureScale,
                         CELL_SIZE * textureScale };
                     DrawTexturePro(
-                        candyTextures[board[r][c].type],
+                        candyTextures[type],
                         sourceRect,
                         destRect,
                         (Vector2) {
@@ -351,7 +556,7 @@ void DrawBoard()
                 else
                 {
                     // Dokular yoksa renkli daireler çiz
-                    Color color = candyColors[board[r][c].type];
+                    Color color = candyColors[type];
                     Rectangle rect = {
                         (float)x + (CELL_SIZE * (1.0f - scale) / 2.0f),
                         (float)y + (CELL_SIZE * (1.0f - scale) / 2.0f),
@@ -362,7 +567,7 @@ void DrawBoard()
             }
 
             // Seçili hücre vurgusu
-            if (selectedCell.selected && selectedCell.row == r && selectedCell.col == c)
+            if (cur->selectedCell.selected && cur->selectedCell.row == r && cur->selectedCell.col == c)
             {
                 DrawRectangleLinesEx((Rectangle) { (float)(x + 2), (float)(y + 2), (float)(CELL_SIZE - 4), (float)(CELL_SIZE - 4) }, 4, GOLD);
             }
@@ -376,35 +581,13 @@ bool LoadCandyTextures()
     bool success = true;
 
     // Dosya varlığını kontrol et ve yükle
-    if (FileExists("assets/candy_red.png"))
-        candyTextures[CANDY_RED] = LoadTexture("assets/candy_red.png");
-    else
-        success = false;
-
-    if (FileExists("assets/candy_green.png"))
-        candyTextures[CANDY_GREEN] = LoadTexture("assets/candy_green.png");
-    else
-        success = false;
-
-    if (FileExists("assets/candy_blue.png"))
-        candyTextures[CANDY_BLUE] = LoadTexture("assets/candy_blue.png");
-    else
-        success = false;
-
-    if (FileExists("assets/candy_yellow.png"))
-        candyTextures[CANDY_YELLOW] = LoadTexture("assets/candy_yellow.png");
-    else
-        success = false;
-
-    if (FileExists("assets/candy_purple.png"))
-        candyTextures[CANDY_PURPLE] = LoadTexture("assets/candy_purple.png");
-    else
-        success = false;
-
-    if (FileExists("assets/candy_orange.png"))
-        candyTextures[CANDY_ORANGE] = LoadTexture("assets/candy_orange.png");
-    else
-        success = false;
+    for (int i = 0; i < CANDY_TYPES; i++)
+    {
+        if (FileExists(candyFiles[i]))
+            candyTextures[i] = LoadTexture(candyFiles[i]);
+        else
+            success = false;
+    }
 
     return success;
 }
@@ -421,144 +604,669 @@ void UnloadCandyTextures()
     }
 }
 
-// Ana fonksiyon
-int main(void)
+// Kuyruğa olay ekle (sadece çizim iş parçacığı); doluysa olay düşürülür
+void PushInputEvent(InputEvent e)
 {
-    // time() geriye time_t döndürür, srand() için unsigned int gerekiyor
-    srand((unsigned int)time(NULL));
-    InitWindow(800, 700, "Candy Crush - Raylib");
-    SetTargetFPS(60);
+    unsigned int head = atomic_load_explicit(&inputHead, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&inputTail, memory_order_acquire);
+    if (head - tail >= INPUT_QUEUE_SIZE)
+    {
+        MetricsCount(METRIC_INPUT_DROPPED, 1);
+        return;
+    }
+    inputQueue[head & (INPUT_QUEUE_SIZE - 1)] = e;
+    atomic_store_explicit(&inputHead, head + 1, memory_order_release);
+}
 
-    // Renkleri burada ayarla - küresel değişken sabit bir değerle başlatılamıyor
-    candyColors[CANDY_RED] = RED;
-    candyColors[CANDY_GREEN] = GREEN;
-    candyColors[CANDY_BLUE] = BLUE;
-    candyColors[CANDY_YELLOW] = YELLOW;
-    candyColors[CANDY_PURPLE] = PURPLE;
-    candyColors[CANDY_ORANGE] = ORANGE;
+// Kuyruktan olay al (sadece simülasyon iş parçacığı)
+bool PopInputEvent(InputEvent *e)
+{
+    unsigned int tail = atomic_load_explicit(&inputTail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&inputHead, memory_order_acquire))
+        return false;
+    *e = inputQueue[tail & (INPUT_QUEUE_SIZE - 1)];
+    atomic_store_explicit(&inputTail, tail + 1, memory_order_release);
+    return true;
+}
 
-    // PNG'leri yüklemeyi dene
-    useTextures = LoadCandyTextures();
+// Ekran konumunu hücreye çevirip tahta üzerindeyse kuyruğa ekle
+void QueuePointerEvent(InputEventType type, int pointerId, Vector2 position, double time)
+{
+    static unsigned int nextSeq = 1;
+    int col = (int)((position.x - BOARD_OFFSET_X) / CELL_SIZE);
+    int row = (int)((position.y - BOARD_OFFSET_Y) / CELL_SIZE);
+    if (row >= 0 && row < game.rows && col >= 0 && col < game.cols && game.kind[row][col] == CELL_PLAYABLE)
+        PushInputEvent((InputEvent){ type, pointerId, row, col, time, nextSeq++ });
+}
 
-    if (!useTextures)
+// Bu karedeki fare ve dokunma basışlarını topla (her karede bir kez)
+void PollInput()
+{
+    static int knownTouchIds[MAX_TOUCH_POINTS];
+    static int knownTouchCount = 0;
+    double now = GetTime();
+    bool touched = false;
+
+    int touchCount = GetTouchPointCount();
+    if (touchCount > MAX_TOUCH_POINTS)
+        touchCount = MAX_TOUCH_POINTS;
+    int ids[MAX_TOUCH_POINTS];
+    for (int i = 0; i < touchCount; i++)
     {
-        TraceLog(LOG_WARNING, "PNG dosyaları yüklenemedi! Renkli şekillerle devam ediliyor.");
+        ids[i] = GetTouchPointId(i);
+        bool isNew = true;
+        for (int k = 0; k < knownTouchCount; k++)
+            if (knownTouchIds[k] == ids[i])
+                isNew = false;
+        if (isNew)
+        {
+            QueuePointerEvent(INPUT_TOUCH_DOWN, ids[i], GetTouchPosition(i), now);
+            touched = true;
+        }
     }
+    memcpy(knownTouchIds, ids, sizeof(int) * touchCount);
+    knownTouchCount = touchCount;
 
-    FillBoardNoMatches();
+    // Dokunmatik ekranlarda raylib dokunmayı fareye de yansıtır, iki kez sayma
+    if (!touched && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+        QueuePointerEvent(INPUT_POINTER_DOWN, 0, GetMousePosition(), now);
+}
 
-    while (!WindowShouldClose())
+// Geçerliyse hamleyi başlat, her durumda seçimi kaldır
+void TryStartSwap(Cell a, Cell b)
+{
+    if (game.levelState == LEVEL_PLAYING && IsValidSwap(a, b))
     {
-        // Animasyonlar
-        isAnimating = UpdateAnimations();
+        SwapCandies(a, b);
+        EngineEmitSwap(&game, CellMove(a, b));
+        isSwapping = true;
+        swapSource = a;
+        swapTarget = b;
+        game.moves++;
+        MetricsCount(METRIC_MOVES, 1);
+    }
+    selectedCell.selected = false;
+}
 
-        // Kullanıcı girişi
-        if (!isAnimating && !isDestroying)
+// Tek bir tıklamayı uygula; tahta meşgulken tamamlanan hamle sıraya alınır
+void HandleInputEvent(const InputEvent *e)
+{
+    bool busy = isAnimating || isDestroying || isSwapping;
+    int row = e->row;
+    int col = e->col;
+    if (!selectedCell.selected)
+    {
+        selectedCell = (Cell){ row, col, true };
+        hasQueuedSwap = false;
+    }
+    else
+    {
+        Cell target = { row, col, false };
+        if (IsAdjacent(selectedCell, target))
         {
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+            if (busy)
             {
-                Vector2 mouse = GetMousePosition();
-                int col = (int)((mouse.x - BOARD_OFFSET_X) / CELL_SIZE);
-                int row = (int)((mouse.y - BOARD_OFFSET_Y) / CELL_SIZE);
-                if (row >= 0 && row < ROWS && col >= 0 && col < COLS)
-                {
-                    if (!selectedCell.selected)
-                    {
-                        selectedCell = (Cell){ row, col, true };
-                    }
-                    else
-                    {
-                        Cell target = { row, col, false };
-                        if (IsAdjacent(selectedCell, target))
-                        {
-                            if (IsValidSwap(selectedCell, target))
-                            {
-                                SwapCandies(selectedCell, target);
-                                isSwapping = true;
-                                swapTarget = target;
-                            }
-                            else
-                            {
-                                // Geçersiz hamle, seçimi kaldır
-                                selectedCell.selected = false;
-                            }
-                        }
-                        else
-                        {
-                            // Aynı hücreye tıklandıysa seçimi kaldır
-                            if (selectedCell.row == row && selectedCell.col == col)
-                                selectedCell.selected = false;
-                            else
-                                selectedCell = (Cell){ row, col, true };
-                        }
-                    }
-                }
+                // Kaskad bitince denenecek
+                hasQueuedSwap = true;
+                queuedSwapSource = selectedCell;
+                queuedSwapTarget = target;
+            }
+            else
+            {
+                TryStartSwap(selectedCell, target);
             }
         }
+        else
+        {
+            // Aynı hücreye tıklandıysa seçimi kaldır
+            if (selectedCell.row == row && selectedCell.col == col)
+                selectedCell.selected = false;
+            else
+                selectedCell = (Cell){ row, col, true };
+            hasQueuedSwap = false;
+        }
+    }
 
-        // Swap sonrası eşleşme kontrolü
-        if (isSwapping && !isAnimating)
+    if (pendingInputCount == PENDING_INPUT_MAX)
+    {
+        memmove(pendingInputs, pendingInputs + 1, sizeof(InputStamp) * (PENDING_INPUT_MAX - 1));
+        pendingInputCount--;
+    }
+    pendingInputs[pendingInputCount++] = (InputStamp){ e->seq, e->time };
+}
+
+// Giriş gecikmesi özeti (tıklama -> etkisini gösteren ilk kare)
+void LogLatencyHistogram()
+{
+    MetricHistogramData h;
+    MetricsRead(METRIC_INPUT_LATENCY, &h);
+    TraceLog(LOG_INFO, "Giriş gecikmesi: %llu örnek, en kötü %.1f ms, düşen olay %llu",
+        (unsigned long long)h.count, (double)h.max / 1000.0,
+        (unsigned long long)MetricsCounter(METRIC_INPUT_DROPPED));
+    for (int b = 0; b < METRIC_BUCKETS; b++)
+    {
+        if (h.buckets[b] > 0)
+            TraceLog(LOG_INFO, "  < %9.3f ms: %llu", (double)(1ULL << b) / 1000.0, (unsigned long long)h.buckets[b]);
+    }
+}
+
+// Tek mantık adımı: animasyon, giriş, eşleşme ve düşürme (sadece simülasyon iş parçacığı)
+void GameTick()
+{
+    // Animasyonlar
+    isAnimating = UpdateAnimations();
+
+    // Kullanıcı girişi: animasyon sırasında da olaylar işlenir, hamleler sıraya alınır
+    InputEvent event;
+    while (PopInputEvent(&event))
+        HandleInputEvent(&event);
+
+    if (hasQueuedSwap && !isAnimating && !isDestroying && !isSwapping)
+    {
+        hasQueuedSwap = false;
+        TryStartSwap(queuedSwapSource, queuedSwapTarget);
+    }
+
+    // Swap sonrası eşleşme kontrolü
+    if (isSwapping && !isAnimating)
+    {
+        ResetDestroyFlags();
+        if (MarkMatches())
         {
+            isDestroying = true;
+            comboActive = true;
+            game.comboMultiplier = 1;
+        }
+        else
+        {
+            // Geri al
+            SwapCandies(swapSource, swapTarget);
+        }
+        isSwapping = false;
+    }
+
+    // Patlatma ve düşürme
+    if (isDestroying && !isAnimating)
+    {
+        int destroyed = 0;
+        if (MarkMatches())
+        {
+            destroyed = DestroyMarkedCandies();
+            AddScore(destroyed);
+            DropCandies();
+            game.comboMultiplier++;
+        }
+        else
+        {
+            isDestroying = false;
+            comboActive = false;
+            MetricsRecord(METRIC_CASCADE_DEPTH, (uint64_t)(game.comboMultiplier - 1));
+            game.comboMultiplier = 1;
             ResetDestroyFlags();
-            if (MarkMatches())
+            ResetScales();
+            EngineCheckLevelEnd(&game);
+            SaveGame();
+        }
+    }
+
+    // Oynanabilir hamle yoksa tahtayı yeniden doldur
+    if (!isAnimating && !isDestroying && !HasValidMove())
+    {
+        double start = GetTime();
+        FillBoardNoMatches();
+        MetricsRecordSeconds(METRIC_RESHUFFLE_TIME, GetTime() - start);
+        MetricsCount(METRIC_RESHUFFLES, 1);
+        SaveGame();
+    }
+}
+
+// Tüketicinin imlecinden oku; yavaş kaldığı için kaçırdıkları telemetriye sayılır
+int PollEvents(EventCursor *cursor, GameEvent *out)
+{
+    uint64_t dropped = cursor->dropped;
+    int count = EventBusPoll(&gameEvents, cursor, out, EVENTS_PER_POLL);
+    if (cursor->dropped != dropped)
+        MetricsCount(METRIC_EVENTS_DROPPED, cursor->dropped - dropped);
+    return count;
+}
+
+Vector2 CellCenter(int row, int col)
+{
+    return (Vector2){ BOARD_OFFSET_X + (col + 0.5f) * CELL_SIZE, BOARD_OFFSET_Y + (row + 0.5f) * CELL_SIZE };
+}
+
+void LoadSounds()
+{
+    for (int i = 0; i < SOUND_COUNT; i++)
+    {
+        if (FileExists(soundFiles[i]))
+        {
+            sounds[i] = LoadSound(soundFiles[i]);
+            soundLoaded[i] = true;
+        }
+    }
+}
+
+void UnloadSounds()
+{
+    for (int i = 0; i < SOUND_COUNT; i++)
+        if (soundLoaded[i])
+            UnloadSound(sounds[i]);
+}
+
+void PlayGameSound(GameSound sound, float pitch)
+{
+    if (!soundLoaded[sound])
+        return;
+    SetSoundPitch(sounds[sound], pitch);
+    PlaySound(sounds[sound]);
+}
+
+// Ses: her karede okunur; kaskad ilerledikçe eşleşme sesi incelir
+void UpdateAudio()
+{
+    GameEvent events[EVENTS_PER_POLL];
+    int count;
+    while ((count = PollEvents(&audioEvents, events)) > 0)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (events[i].type == EVENT_SWAP)
+                PlayGameSound(SOUND_SWAP, 1.0f);
+            else if (events[i].type == EVENT_CASCADE_STEP)
+                PlayGameSound(SOUND_MATCH, 1.0f + 0.1f * (float)(events[i].cascade.step - 1));
+            else if (events[i].type == EVENT_LEVEL_WON)
+                PlayGameSound(SOUND_WIN, 1.0f);
+            else if (events[i].type == EVENT_LEVEL_LOST)
+                PlayGameSound(SOUND_LOSE, 1.0f);
+        }
+    }
+}
+
+// Parçacıklar: her hücreden şeker parçaları ve kıvılcım; 4'lü dizi satırı/sütunu boyunca
+// şerit, 5'li dizi ve L/T tüm grubun ortasından renk bombası halkası
+void EmitMatchEffects(const MatchGroup *group)
+{
+    Color color = candyColors[group->type];
+    Vector2 middle = { 0 };
+    for (int i = 0; i < group->count; i++)
+    {
+        Vector2 center = CellCenter(group->row[i], group->col[i]);
+        middle.x += center.x / group->count;
+        middle.y += center.y / group->count;
+
+        ParticleBurst debris = { center, { 8, 8 }, 4, 60, 220, 0.7f, 18, 700, useTextures ? WHITE : color, group->type + 1 };
+        ParticleBurst sparks = { center, { 4, 4 }, 10, 80, 300, 0.45f, 10, 0, color, PARTICLE_SPRITE_SPARK };
+        ParticlesEmit(&particles, &debris);
+        ParticlesEmit(&particles, &sparks);
+    }
+
+    if (group->shape == MATCH_LINE4)
+    {
+        float width = game.cols * CELL_SIZE * 0.5f, height = game.rows * CELL_SIZE * 0.5f;
+        ParticleBurst stripe = { middle, { 4, 4 }, 0, 20, 120, 0.5f, 12, 0, color, PARTICLE_SPRITE_SPARK };
+        if (group->row[0] == group->row[1])
+        {
+            stripe.position.x = BOARD_OFFSET_X + width;
+            stripe.spread.x = width;
+            stripe.count = 12 * game.cols;
+        }
+        else
+        {
+            stripe.position.y = BOARD_OFFSET_Y + height;
+            stripe.spread.y = height;
+            stripe.count = 12 * game.rows;
+        }
+        ParticlesEmit(&particles, &stripe);
+    }
+    else if (group->shape == MATCH_LINE5 || group->shape == MATCH_LT)
+    {
+        ParticleBurst ring = { middle, { 2, 2 }, 240, 420, 460, 0.8f, 14, 0, color, PARTICLE_SPRITE_SPARK };
+        ParticlesEmit(&particles, &ring);
+    }
+}
+
+void UpdateParticles(float dt)
+{
+    GameEvent events[EVENTS_PER_POLL];
+    int count;
+    while ((count = PollEvents(&particleEvents, events)) > 0)
+        for (int i = 0; i < count; i++)
+            if (events[i].type == EVENT_MATCH)
+                EmitMatchEffects(&events[i].match);
+    ParticlesUpdate(&particles, dt);
+}
+
+// Puan yazıları: adımdaki eşleşmelerin ortasından kazanılan puan yükselip kaybolur
+void UpdateScorePopups(float dt)
+{
+    static Vector2 sum = { 0 };
+    static int cells = 0;
+    GameEvent events[EVENTS_PER_POLL];
+    int count;
+    while ((count = PollEvents(&popupEvents, events)) > 0)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            const GameEvent *e = &events[i];
+            if (e->type == EVENT_MATCH)
             {
-                isDestroying = true;
-                comboActive = true;
-                comboMultiplier = 1;
+                for (int k = 0; k < e->match.count; k++)
+                {
+                    Vector2 center = CellCenter(e->match.row[k], e->match.col[k]);
+                    sum.x += center.x;
+                    sum.y += center.y;
+                    cells++;
+                }
             }
-            else
+            else if (e->type == EVENT_CASCADE_STEP)
             {
-                // Geri al
-                SwapCandies(selectedCell, swapTarget);
-                isSwapping = false;
-                selectedCell.selected = false;
+                if (cells > 0 && e->cascade.scoreGained > 0)
+                {
+                    // En az ömrü kalan yazının yerine
+                    int slot = 0;
+                    for (int k = 1; k < MAX_SCORE_POPUPS; k++)
+                        if (popups[k].life < popups[slot].life)
+                            slot = k;
+                    popups[slot] = (ScorePopup){ { sum.x / cells, sum.y / cells }, e->cascade.scoreGained, 1.0f };
+                }
+                sum = (Vector2){ 0 };
+                cells = 0;
             }
-            isSwapping = false;
         }
+    }
 
-        // Patlatma ve düşürme
-        if (isDestroying && !isAnimating)
+    for (int i = 0; i < MAX_SCORE_POPUPS; i++)
+    {
+        if (popups[i].life > 0.0f)
         {
-            int destroyed = 0;
-            if (MarkMatches())
-            {
-                destroyed = DestroyMarkedCandies();
-                AddScore(destroyed);
-                DropCandies();
-                comboMultiplier++;
-            }
-            else
+            popups[i].life -= dt;
+            popups[i].position.y -= 40.0f * dt;
+        }
+    }
+}
+
+void DrawScorePopups()
+{
+    for (int i = 0; i < MAX_SCORE_POPUPS; i++)
+    {
+        if (popups[i].life <= 0.0f)
+            continue;
+        const char *text = TextFormat("+%d", popups[i].points);
+        int width = MeasureText(text, 28);
+        DrawText(text, (int)popups[i].position.x - width / 2, (int)popups[i].position.y - 14, 28,
+            Fade(DARKBLUE, popups[i].life));
+    }
+}
+
+// Telemetri: kendi seyrek takvimiyle toplu okur
+void UpdateTelemetry()
+{
+    GameEvent events[EVENTS_PER_POLL];
+    int count;
+    while ((count = PollEvents(&telemetryEvents, events)) > 0)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (events[i].type == EVENT_MATCH)
+                MetricsCount(METRIC_MATCHES, 1);
+            else if (events[i].type == EVENT_CASCADE_STEP)
+                MetricsRecord(METRIC_DESTROYED_PER_STEP, (uint64_t)events[i].cascade.destroyed);
+        }
+    }
+}
+
+// Simülasyon iş parçacığı: çizimden bağımsız, sabit TICK_RATE ile çalışır
+int SimulationThread(void *arg)
+{
+    (void)arg;
+    unsigned long long tick = 0;
+    double nextTick = GetTime();
+    while (atomic_load(&simRunning))
+    {
+        double now = GetTime();
+        int ticks = 0;
+        while (now >= nextTick && ticks < MAX_TICKS_PER_UPDATE)
+        {
+            // Hızlı ileri sarmada her yayında birden fazla adım at
+            int speed = atomic_load_explicit(&simSpeed, memory_order_relaxed);
+            for (int i = 0; i < speed; i++)
             {
-                isDestroying = false;
-                comboActive = false;
-                comboMultiplier = 1;
-                selectedCell.selected = false;
-                ResetDestroyFlags();
-                ResetScales();
+                double start = GetTime();
+                GameTick();
+                MetricsRecordSeconds(METRIC_LOGIC_TIME, GetTime() - start);
             }
+            MetricsCount(METRIC_TICKS, (uint64_t)speed);
+            PublishSnapshot(++tick);
+            nextTick += TICK_DT;
+            ticks++;
         }
+        if (ticks == MAX_TICKS_PER_UPDATE)
+            nextTick = now;
 
-        // Oynanabilir hamle yoksa tahtayı yeniden doldur
-        if (!isAnimating && !isDestroying && !HasValidMove())
+        double wait = nextTick - GetTime();
+        if (wait > 0.0)
+            thrd_sleep(&(struct timespec){ .tv_nsec = (long)(wait * 1e9) }, NULL);
+    }
+    return 0;
+}
+
+// Seviye düzenini dosyadan yükle; yoksa ya da hatalıysa varsayılan dikdörtgen tahta
+void LoadLevel(const char *path)
+{
+    char *text = path != NULL ? LoadFileText(path) : NULL;
+    if (text != NULL && EngineLoadLevel(&game, text))
+    {
+        levelHash = BoardBankLevelHash(text);
+    }
+    else
+    {
+        if (path != NULL)
+            TraceLog(LOG_WARNING, "Seviye dosyası okunamadı: %s, varsayılan tahta kullanılıyor.", path);
+        EngineLoadLevel(&game, NULL);
+        levelHash = 0;
+    }
+    if (text != NULL)
+        UnloadFileText(text);
+    startBoards = BoardBankFind(&boardBank, levelHash, START_BOARD_TIER);
+}
+
+// Parçacık yükü testi: sürekli PARTICLE_BENCH_COUNT canlı parçacık, kare sınırı yok
+void RunParticleBench()
+{
+    SetTargetFPS(0);
+    double totalTime = 0.0, worstFrame = 0.0;
+    unsigned long long frames = 0;
+    while (!WindowShouldClose())
+    {
+        float dt = GetFrameTime();
+        while (particles.count < PARTICLE_BENCH_COUNT)
         {
-            FillBoardNoMatches();
+            ParticleBurst burst = {
+                { (float)GetRandomValue(0, GetScreenWidth()), (float)GetRandomValue(0, GetScreenHeight()) },
+                { 40, 40 }, 500, 20, 200, 2.0f, 12, 150, candyColors[GetRandomValue(0, CANDY_TYPES - 1)],
+                GetRandomValue(0, CANDY_TYPES) };
+            ParticlesEmit(&particles, &burst);
         }
 
+        double start = GetTime();
+        ParticlesUpdate(&particles, dt);
+        double updateTime = GetTime() - start;
+
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        ParticlesDraw(&particles);
+        DrawRectangle(0, 0, 420, 70, Fade(RAYWHITE, 0.8f));
+        DrawText(TextFormat("%d parçacık, %d FPS", particles.count, GetFPS()), 10, 10, 24, DARKBLUE);
+        DrawText(TextFormat("güncelleme %.2f ms", updateTime * 1000.0), 10, 40, 20, DARKGRAY);
+        EndDrawing();
+
+        // İlk kareler yükleme ve ısınma içerir
+        if (++frames > 60)
+        {
+            totalTime += dt;
+            if (dt > worstFrame)
+                worstFrame = dt;
+        }
+        MetricsRecordSeconds(METRIC_FRAME_TIME, dt);
+        MetricsRecordSeconds(METRIC_PARTICLE_TIME, updateTime);
+    }
+    if (frames > 60)
+        TraceLog(LOG_INFO, "Parçacık testi: %d parçacık, ortalama %.2f ms/kare (%.0f FPS), en kötü %.2f ms",
+            PARTICLE_BENCH_COUNT, totalTime * 1000.0 / (frames - 60), (frames - 60) / totalTime, worstFrame * 1000.0);
+}
+
+// Ana fonksiyon; isteğe bağlı ilk argüman seviye düzeni dosyası (örn. levels/jelly.txt)
+int main(int argc, char **argv)
+{
+    // time() geriye time_t döndürür, srand() için unsigned int gerekiyor
+    srand((unsigned int)time(NULL));
+    EngineSeed(&game, (uint64_t)time(NULL));
+    game.comboMultiplier = 1;
+    MetricsInit(METRICS_FILE, METRICS_FLUSH_SECONDS, METRICS_MAX_BYTES);
+    bool particleBench = argc > 1 && strcmp(argv[1], "--particle-bench") == 0;
+    BoardBankOpen(&boardBank, BOARD_BANK_FILE);
+    LoadLevel(argc > 1 && !particleBench ? argv[1] : NULL);
+
+    // Pencere en az eski boyutta, büyük seviyelerde tahtaya göre büyür
+    int windowWidth = BOARD_OFFSET_X * 2 + game.cols * CELL_SIZE;
+    int windowHeight = BOARD_OFFSET_Y + game.rows * CELL_SIZE + 40;
+    InitWindow(windowWidth > 800 ? windowWidth : 800, windowHeight > 700 ? windowHeight : 700, "Candy Crush - Raylib");
+    SetTargetFPS(60);
+
+    // Renkleri burada ayarla - küresel değişken sabit bir değerle başlatılamıyor
+    candyColors[CANDY_RED] = RED;
+    candyColors[CANDY_GREEN] = GREEN;
+    candyColors[CANDY_BLUE] = BLUE;
+    candyColors[CANDY_YELLOW] = YELLOW;
+    candyColors[CANDY_PURPLE] = PURPLE;
+    candyColors[CANDY_ORANGE] = ORANGE;
+
+    // PNG'leri yüklemeyi dene
+    double loadStart = GetTime();
+    useTextures = LoadCandyTextures();
+    MetricsRecordSeconds(METRIC_ASSET_LOAD_TIME, GetTime() - loadStart);
+
+    if (!useTextures)
+    {
+        TraceLog(LOG_WARNING, "PNG dosyaları yüklenemedi! Renkli şekillerle devam ediliyor.");
+    }
+    ParticlesInit(&particles, candyFiles, CANDY_TYPES, (uint32_t)time(NULL));
+
+    if (particleBench)
+    {
+        RunParticleBench();
+        ParticlesUnload(&particles);
+        UnloadCandyTextures();
+        CloseWindow();
+        MetricsShutdown();
+        BoardBankClose(&boardBank);
+        return 0;
+    }
+
+    InitAudioDevice();
+    LoadSounds();
+
+    // Tüketiciler simülasyon başlamadan abone olur
+    EventBusInit(&gameEvents);
+    game.events = &gameEvents;
+    EventCursorInit(&gameEvents, &audioEvents);
+    EventCursorInit(&gameEvents, &particleEvents);
+    EventCursorInit(&gameEvents, &popupEvents);
+    EventCursorInit(&gameEvents, &telemetryEvents);
+
+    // Bekçi yeniden başlattıysa kaldığı yerden devam et
+    if (!LoadGame())
+        FillBoardNoMatches();
+    EngineCheckLevelEnd(&game);
+
+    // İlk görüntüyü yayınla, sonra simülasyonu kendi iş parçacığında başlat
+    BoardSnapshot renderPrev;
+    PublishSnapshot(0);
+    AcquireSnapshot(&renderPrev);
+    renderPrev = snapshots[snapshotFront];
+
+    thrd_t simThread;
+    if (thrd_create(&simThread, SimulationThread, NULL) != thrd_success)
+    {
+        TraceLog(LOG_ERROR, "Simülasyon iş parçacığı başlatılamadı!");
+        CloseWindow();
+        MetricsShutdown();
+        return 1;
+    }
+
+    unsigned long long frame = 0;
+    while (!WindowShouldClose())
+    {
+        // Kullanıcı girişi: sadece topla, işlemeyi simülasyon yapar
+        PollInput();
+
+        // TAB basılıyken hızlı ileri sar
+        atomic_store_explicit(&simSpeed, IsKeyDown(KEY_TAB) ? FAST_FORWARD_SPEED : 1, memory_order_relaxed);
+
+        AcquireSnapshot(&renderPrev);
+        const BoardSnapshot *cur = &snapshots[snapshotFront];
+        float alpha = (float)((GetTime() - cur->time) / TICK_DT);
+        if (alpha > 1.0f)
+            alpha = 1.0f;
+
+        // Olay tüketicileri
+        UpdateAudio();
+        UpdateParticles(GetFrameTime());
+        UpdateScorePopups(GetFrameTime());
+        if (++frame % TELEMETRY_POLL_FRAMES == 0)
+            UpdateTelemetry();
+
         // Çizim
         BeginDrawing();
         ClearBackground(RAYWHITE);
 
-        DrawText(TextFormat("Skor: %d", score), 100, 40, 36, DARKBLUE);
-        if (comboActive && comboMultiplier > 1)
-            DrawText(TextFormat("Combo x%d!", comboMultiplier - 1), 400, 40, 36, RED);
+        DrawText(TextFormat("Skor: %d", cur->score), 100, 40, 36, DARKBLUE);
+        if (cur->comboActive && cur->comboMultiplier > 1)
+            DrawText(TextFormat("Combo x%d!", cur->comboMultiplier - 1), 400, 40, 36, RED);
+        if (cur->jellyLeft > 0)
+            DrawText(TextFormat("Jöle: %d", cur->jellyLeft), 100, 10, 24, PINK);
+        if (cur->movesLeft >= 0)
+            DrawText(TextFormat("Hamle: %d", cur->movesLeft), 250, 10, 24, DARKGRAY);
+        if (cur->levelState == LEVEL_WON)
+            DrawText("Seviye tamam!", 400, 10, 24, DARKGREEN);
+        else if (cur->levelState == LEVEL_LOST)
+            DrawText("Hamle kalmadı", 400, 10, 24, RED);
 
-        DrawBoard();
+        DrawBoard(&renderPrev, cur, alpha);
+        ParticlesDraw(&particles);
+        DrawScorePopups();
 
         EndDrawing();
+        MetricsRecordSeconds(METRIC_FRAME_TIME, GetFrameTime());
+        MetricsCount(METRIC_FRAMES, 1);
+
+        // Tıklamanın etkisini gösteren ilk kare ekrana verildi
+        unsigned int measured = atomic_load_explicit(&measuredInputSeq, memory_order_relaxed);
+        double presented = GetTime();
+        for (int i = 0; i < cur->inputCount; i++)
+        {
+            if ((int)(cur->inputs[i].seq - measured) > 0)
+            {
+                MetricsRecordSeconds(METRIC_INPUT_LATENCY, presented - cur->inputs[i].time);
+                measured = cur->inputs[i].seq;
+            }
+        }
+        atomic_store_explicit(&measuredInputSeq, measured, memory_order_release);
     }
 
+    atomic_store(&simRunning, false);
+    thrd_join(simThread, NULL);
+    UpdateTelemetry();
+    LogLatencyHistogram();
+    MetricsShutdown();
+    BoardBankClose(&boardBank);
+
     // Dokuları bellekten boşalt
+    ParticlesUnload(&particles);
     UnloadCandyTextures();
+    UnloadSounds();
+    CloseAudioDevice();
 
     CloseWindow();
     return 0;
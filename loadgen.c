@@ -0,0 +1,337 @@
+// Sunucu için yük üreteci: her bağlantı ayrı bir oturumdur, geçerli hamleleri
+// yerel motorla bulup gönderir ve istek-yanıt gecikmesini histogramda toplar.
+//
+// Derleme (Linux): cc -O2 -std=c11 loadgen.c engine.c arena.c eventbus.c -o loadgen -lpthread
+// Kullanım: ./loadgen [--port 7777] [--connections 1000] [--threads 4] [--seconds 10] [--invalid 0.01]
+
+#define _GNU_SOURCE
+#include "engine.h"
+#include "netproto.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#define MAX_THREADS 64
+#define MAX_EVENTS 256
+#define SUB_BUCKETS 8 // Her 2'nin kuvveti aralığı 8 eşit parçaya bölünür (~%12 çözünürlük)
+#define HISTOGRAM_SIZE (64 * SUB_BUCKETS)
+
+typedef struct
+{
+    uint64_t counts[HISTOGRAM_SIZE];
+    uint64_t total;
+    uint64_t maxNs;
+} Histogram;
+
+typedef struct
+{
+    int fd;
+    uint32_t sessionId;
+    Engine local; // Sadece hamle seçmek için, sunucunun tahtasının kopyası
+    unsigned char in[sizeof(NetResponse)];
+    size_t inLen;
+    uint64_t sentAt;
+    bool sentInvalid; // Son gönderilen hamle bilerek geçersizdi
+} Client;
+
+typedef struct
+{
+    int index;
+    int firstSession;
+    int clientCount;
+    Histogram latency;
+    uint64_t moves, invalidSent, invalidReceived, disagreements, errors;
+} LoadThread;
+
+static int port = NET_DEFAULT_PORT;
+static int connectionCount = 1000;
+static int threadCount = 4;
+static double seconds = 10.0;
+static double invalidRate = 0.01;
+static atomic_bool running = true;
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int BucketOf(uint64_t ns)
+{
+    if (ns < SUB_BUCKETS)
+        return (int)ns;
+    int octave = 63 - __builtin_clzll(ns);
+    int sub = (int)((ns >> (octave - 3)) & (SUB_BUCKETS - 1));
+    return (octave - 2) * SUB_BUCKETS + sub;
+}
+
+// Kovanın üst sınırı (ns)
+static uint64_t BucketLimit(int bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return (uint64_t)bucket + 1;
+    int octave = bucket / SUB_BUCKETS + 2;
+    uint64_t sub = (uint64_t)(bucket % SUB_BUCKETS);
+    return ((SUB_BUCKETS + sub + 1) << (octave - 3));
+}
+
+static void Record(Histogram *h, uint64_t ns)
+{
+    h->counts[BucketOf(ns)]++;
+    h->total++;
+    if (ns > h->maxNs)
+        h->maxNs = ns;
+}
+
+static double Percentile(const Histogram *h, double p)
+{
+    uint64_t target = (uint64_t)((double)h->total * p);
+    uint64_t seen = 0;
+    for (int b = 0; b < HISTOGRAM_SIZE; b++)
+    {
+        seen += h->counts[b];
+        if (seen > target)
+            return (double)BucketLimit(b) / 1000.0;
+    }
+    return (double)h->maxNs / 1000.0;
+}
+
+static uint64_t NextRandom(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// Geçerli hamlelerden rastgele birini seç
+static bool PickValidMove(Engine *e, uint64_t *rng, Move *out)
+{
+    MoveList moves;
+    if (EngineGenerateMoves(e, &moves) == 0)
+        return false;
+    *out = moves.moves[NextRandom(rng) % (uint64_t)moves.count];
+    return true;
+}
+
+static bool SendRequest(Client *c, uint8_t op, Move move)
+{
+    NetRequest req;
+    memset(&req, 0, sizeof(req));
+    req.sessionId = c->sessionId;
+    req.op = op;
+    req.move = move;
+    c->sentAt = NowNs();
+    return send(c->fd, &req, sizeof(req), MSG_NOSIGNAL) == (ssize_t)sizeof(req);
+}
+
+static int Connect(void)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+// Tam bir yanıt geldi: gecikmeyi kaydet, sonraki hamleyi gönder
+static bool OnResponse(LoadThread *t, Client *c, const NetResponse *res, uint64_t *rng)
+{
+    bool wasInvalid = c->sentInvalid;
+    c->sentInvalid = false;
+    if (res->op == NET_OP_MOVE)
+    {
+        Record(&t->latency, NowNs() - c->sentAt);
+        t->moves++;
+        if (res->status == NET_STATUS_INVALID_MOVE)
+        {
+            t->invalidReceived++;
+            if (!wasInvalid)
+                t->disagreements++; // Geçerli sandığımız hamleyi sunucu reddetti
+        }
+        else if (wasInvalid)
+        {
+            t->disagreements++;
+        }
+    }
+    else if (res->status != NET_STATUS_OK)
+    {
+        t->errors++;
+    }
+
+    for (int r = 0; r < ROWS; r++)
+        memcpy(c->local.type[r], res->type[r], sizeof(res->type[r]));
+    if (!atomic_load_explicit(&running, memory_order_relaxed))
+        return true;
+
+    Move m = { 0, 0, 0, 0 };
+    if ((double)(NextRandom(rng) % 1000000) / 1e6 < invalidRate)
+    {
+        // Doğrulamayı da zorlamak için bilerek komşu olmayan hamle
+        m = (Move){ 0, 0, 2, 2 };
+        c->sentInvalid = true;
+        t->invalidSent++;
+    }
+    else if (!PickValidMove(&c->local, rng, &m))
+    {
+        return SendRequest(c, NET_OP_STATE, m);
+    }
+    return SendRequest(c, NET_OP_MOVE, m);
+}
+
+static int LoadThreadMain(void *arg)
+{
+    LoadThread *t = arg;
+    uint64_t rng = 0x9E3779B97F4A7C15ull * (uint64_t)(t->index + 1);
+    int epollFd = epoll_create1(0);
+    Client *clients = calloc((size_t)t->clientCount, sizeof(Client));
+    if (epollFd < 0 || clients == NULL)
+        return 1;
+
+    for (int i = 0; i < t->clientCount; i++)
+    {
+        Client *c = &clients[i];
+        c->sessionId = (uint32_t)(t->firstSession + i);
+        EngineLoadLevel(&c->local, NULL);
+        c->fd = Connect();
+        if (c->fd < 0)
+        {
+            t->errors++;
+            continue;
+        }
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = c };
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, c->fd, &ev);
+        if (!SendRequest(c, NET_OP_HELLO, (Move){ 0, 0, 0, 0 }))
+            t->errors++;
+    }
+
+    struct epoll_event events[MAX_EVENTS];
+    int open = t->clientCount;
+    while (open > 0)
+    {
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, 200);
+        if (n == 0 && !atomic_load(&running))
+            break;
+        for (int i = 0; i < n; i++)
+        {
+            Client *c = events[i].data.ptr;
+            ssize_t got = recv(c->fd, c->in + c->inLen, sizeof(c->in) - c->inLen, 0);
+            if (got <= 0)
+            {
+                if (got < 0 && (errno == EAGAIN || errno == EINTR))
+                    continue;
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, c->fd, NULL);
+                close(c->fd);
+                c->fd = -1;
+                open--;
+                continue;
+            }
+            c->inLen += (size_t)got;
+            if (c->inLen < sizeof(NetResponse))
+                continue;
+            NetResponse res;
+            memcpy(&res, c->in, sizeof(res));
+            c->inLen = 0;
+            if (!OnResponse(t, c, &res, &rng))
+                t->errors++;
+        }
+    }
+
+    for (int i = 0; i < t->clientCount; i++)
+        if (clients[i].fd >= 0)
+            close(clients[i].fd);
+    free(clients);
+    close(epollFd);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (strcmp(argv[i], "--port") == 0)
+            port = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--connections") == 0)
+            connectionCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--threads") == 0)
+            threadCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seconds") == 0)
+            seconds = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "--invalid") == 0)
+            invalidRate = atof(argv[i + 1]);
+    }
+    if (threadCount < 1 || threadCount > MAX_THREADS || connectionCount < threadCount)
+    {
+        fprintf(stderr, "--threads 1..%d ve --connections >= --threads olmalı\n", MAX_THREADS);
+        return 1;
+    }
+
+    static LoadThread threads[MAX_THREADS];
+    thrd_t handles[MAX_THREADS];
+    int perThread = connectionCount / threadCount;
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads[i].index = i;
+        threads[i].firstSession = i * perThread;
+        threads[i].clientCount = (i == threadCount - 1) ? connectionCount - i * perThread : perThread;
+        thrd_create(&handles[i], LoadThreadMain, &threads[i]);
+    }
+
+    uint64_t start = NowNs();
+    thrd_sleep(&(struct timespec){ .tv_sec = (time_t)seconds, .tv_nsec = (long)((seconds - (double)(time_t)seconds) * 1e9) }, NULL);
+    atomic_store(&running, false);
+
+    Histogram total;
+    memset(&total, 0, sizeof(total));
+    uint64_t moves = 0, invalidSent = 0, invalidReceived = 0, disagreements = 0, errors = 0;
+    for (int i = 0; i < threadCount; i++)
+    {
+        thrd_join(handles[i], NULL);
+        LoadThread *t = &threads[i];
+        for (int b = 0; b < HISTOGRAM_SIZE; b++)
+            total.counts[b] += t->latency.counts[b];
+        total.total += t->latency.total;
+        if (t->latency.maxNs > total.maxNs)
+            total.maxNs = t->latency.maxNs;
+        moves += t->moves;
+        invalidSent += t->invalidSent;
+        invalidReceived += t->invalidReceived;
+        disagreements += t->disagreements;
+        errors += t->errors;
+    }
+    double elapsed = (double)(NowNs() - start) * 1e-9;
+
+    printf("%d bağlantı, %.1f s: %llu hamle, %.0f hamle/s\n", connectionCount, elapsed,
+        (unsigned long long)moves, (double)moves / elapsed);
+    printf("gecikme (us): p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  en kötü %.1f\n",
+        Percentile(&total, 0.50), Percentile(&total, 0.90), Percentile(&total, 0.99),
+        Percentile(&total, 0.999), (double)total.maxNs / 1000.0);
+    printf("geçersiz gönderilen %llu, reddedilen %llu, uyuşmazlık %llu, hata %llu\n",
+        (unsigned long long)invalidSent, (unsigned long long)invalidReceived,
+        (unsigned long long)disagreements, (unsigned long long)errors);
+    return disagreements == 0 && errors == 0 ? 0 : 1;
+}
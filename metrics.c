@@ -0,0 +1,218 @@
+#ifndef METRICS_DISABLED
+
+#include "metrics.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <time.h>
+#include <threads.h>
+#include <stdatomic.h>
+
+#define METRICS_MAX_SHARDS 16 // Son parça taşan iş parçacıklarınca paylaşılır
+#define METRICS_ROTATE_KEEP 3
+#define METRICS_PATH_MAX 256
+
+// Her alanın tek yazarı var (paylaşılan son parça hariç), okuyucu sadece yazıcı
+// iş parçacığı; bu yüzden atomik değişkenler kilitli işlem yerine load/store ile artırılır.
+typedef struct
+{
+    _Alignas(64) atomic_uint_fast64_t counters[METRIC_COUNTER_COUNT];
+    atomic_uint_fast64_t count[METRIC_HISTOGRAM_COUNT];
+    atomic_uint_fast64_t sum[METRIC_HISTOGRAM_COUNT];
+    atomic_uint_fast64_t max[METRIC_HISTOGRAM_COUNT];
+    atomic_uint_fast64_t buckets[METRIC_HISTOGRAM_COUNT][METRIC_BUCKETS];
+    bool shared;
+} MetricShard;
+
+static const char *counterNames[METRIC_COUNTER_COUNT] = {
+    "frames", "ticks", "moves", "reshuffles", "input_dropped", "matches", "events_dropped"
+};
+
+static const char *histogramNames[METRIC_HISTOGRAM_COUNT] = {
+    "frame_time_us", "logic_time_us", "input_latency_us", "cascade_depth",
+    "destroyed_per_step", "reshuffle_time_us", "asset_load_time_us",
+    "particle_time_us"
+};
+
+static MetricShard shards[METRICS_MAX_SHARDS] = { [METRICS_MAX_SHARDS - 1] = { .shared = true } };
+static atomic_int shardsClaimed = 0;
+static thread_local MetricShard *localShard = NULL;
+
+static char metricsPath[METRICS_PATH_MAX];
+static long metricsMaxBytes;
+static double metricsFlushSeconds;
+static struct timespec metricsStart;
+static thrd_t flushThread;
+static mtx_t flushLock;
+static cnd_t flushWake;
+static bool flushRunning = false; // flushLock altında
+
+static MetricShard *LocalShard(void)
+{
+    if (localShard == NULL)
+    {
+        int index = atomic_fetch_add(&shardsClaimed, 1);
+        if (index >= METRICS_MAX_SHARDS - 1)
+            index = METRICS_MAX_SHARDS - 1;
+        localShard = &shards[index];
+    }
+    return localShard;
+}
+
+static inline void Add(MetricShard *s, atomic_uint_fast64_t *field, uint64_t n)
+{
+    if (s->shared)
+        atomic_fetch_add_explicit(field, n, memory_order_relaxed);
+    else
+        atomic_store_explicit(field, atomic_load_explicit(field, memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+void MetricsCount(MetricCounter counter, uint64_t n)
+{
+    MetricShard *s = LocalShard();
+    Add(s, &s->counters[counter], n);
+}
+
+void MetricsRecord(MetricHistogram histogram, uint64_t value)
+{
+    MetricShard *s = LocalShard();
+    int bucket = 0;
+    while ((value >> bucket) > 0 && bucket < METRIC_BUCKETS - 1)
+        bucket++;
+    Add(s, &s->buckets[histogram][bucket], 1);
+    Add(s, &s->count[histogram], 1);
+    Add(s, &s->sum[histogram], value);
+
+    // Paylaşılan parçada nadiren kaybolan bir en büyük değer kabul edilebilir
+    if (value > atomic_load_explicit(&s->max[histogram], memory_order_relaxed))
+        atomic_store_explicit(&s->max[histogram], value, memory_order_relaxed);
+}
+
+void MetricsRecordSeconds(MetricHistogram histogram, double seconds)
+{
+    MetricsRecord(histogram, seconds > 0.0 ? (uint64_t)(seconds * 1e6) : 0);
+}
+
+uint64_t MetricsCounter(MetricCounter counter)
+{
+    uint64_t total = 0;
+    for (int i = 0; i < METRICS_MAX_SHARDS; i++)
+        total += atomic_load_explicit(&shards[i].counters[counter], memory_order_relaxed);
+    return total;
+}
+
+void MetricsRead(MetricHistogram histogram, MetricHistogramData *out)
+{
+    *out = (MetricHistogramData){ 0 };
+    for (int i = 0; i < METRICS_MAX_SHARDS; i++)
+    {
+        const MetricShard *s = &shards[i];
+        out->count += atomic_load_explicit(&s->count[histogram], memory_order_relaxed);
+        out->sum += atomic_load_explicit(&s->sum[histogram], memory_order_relaxed);
+        uint64_t max = atomic_load_explicit(&s->max[histogram], memory_order_relaxed);
+        if (max > out->max)
+            out->max = max;
+        for (int b = 0; b < METRIC_BUCKETS; b++)
+            out->buckets[b] += atomic_load_explicit(&s->buckets[histogram][b], memory_order_relaxed);
+    }
+}
+
+// path -> path.1 -> path.2 ...; en eskisi silinir
+static void RotateFiles(void)
+{
+    char from[METRICS_PATH_MAX + 8], to[METRICS_PATH_MAX + 8];
+    snprintf(to, sizeof(to), "%s.%d", metricsPath, METRICS_ROTATE_KEEP);
+    remove(to);
+    for (int i = METRICS_ROTATE_KEEP - 1; i >= 1; i--)
+    {
+        snprintf(from, sizeof(from), "%s.%d", metricsPath, i);
+        snprintf(to, sizeof(to), "%s.%d", metricsPath, i + 1);
+        rename(from, to);
+    }
+    snprintf(to, sizeof(to), "%s.1", metricsPath);
+    rename(metricsPath, to);
+}
+
+// Toplam değerleri tek JSON satırı olarak ekle; okuyan taraf ardışık satırların farkını alır
+static void Flush(void)
+{
+    FILE *file = fopen(metricsPath, "ab");
+    if (file == NULL)
+        return;
+
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    double uptime = (double)(now.tv_sec - metricsStart.tv_sec) + (double)(now.tv_nsec - metricsStart.tv_nsec) / 1e9;
+    fprintf(file, "{\"time\":%lld,\"uptime\":%.3f,\"counters\":{", (long long)now.tv_sec, uptime);
+    for (int c = 0; c < METRIC_COUNTER_COUNT; c++)
+        fprintf(file, "%s\"%s\":%llu", c ? "," : "", counterNames[c], (unsigned long long)MetricsCounter(c));
+    fprintf(file, "},\"histograms\":{");
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++)
+    {
+        MetricHistogramData data;
+        MetricsRead(h, &data);
+        int used = METRIC_BUCKETS;
+        while (used > 0 && data.buckets[used - 1] == 0)
+            used--;
+        fprintf(file, "%s\"%s\":{\"count\":%llu,\"sum\":%llu,\"max\":%llu,\"buckets\":[", h ? "," : "",
+            histogramNames[h], (unsigned long long)data.count, (unsigned long long)data.sum,
+            (unsigned long long)data.max);
+        for (int b = 0; b < used; b++)
+            fprintf(file, "%s%llu", b ? "," : "", (unsigned long long)data.buckets[b]);
+        fprintf(file, "]}");
+    }
+    fprintf(file, "}}\n");
+
+    bool full = ftell(file) >= metricsMaxBytes;
+    fclose(file);
+    if (full)
+        RotateFiles();
+}
+
+// Dosya yazımı oyun iş parçacıklarını hiç bekletmesin diye ayrı iş parçacığında
+static int FlushThread(void *arg)
+{
+    (void)arg;
+    mtx_lock(&flushLock);
+    while (flushRunning)
+    {
+        struct timespec until;
+        timespec_get(&until, TIME_UTC);
+        double wake = (double)until.tv_nsec / 1e9 + metricsFlushSeconds;
+        until.tv_sec += (time_t)wake;
+        until.tv_nsec = (long)((wake - (double)(time_t)wake) * 1e9);
+        if (cnd_timedwait(&flushWake, &flushLock, &until) == thrd_timedout)
+            Flush();
+    }
+    mtx_unlock(&flushLock);
+    return 0;
+}
+
+void MetricsInit(const char *path, double flushSeconds, long maxBytes)
+{
+    snprintf(metricsPath, sizeof(metricsPath), "%s", path);
+    metricsFlushSeconds = flushSeconds;
+    metricsMaxBytes = maxBytes;
+    timespec_get(&metricsStart, TIME_UTC);
+
+    mtx_init(&flushLock, mtx_plain);
+    cnd_init(&flushWake);
+    flushRunning = true;
+    if (thrd_create(&flushThread, FlushThread, NULL) != thrd_success)
+        flushRunning = false;
+}
+
+void MetricsShutdown(void)
+{
+    mtx_lock(&flushLock);
+    bool wasRunning = flushRunning;
+    flushRunning = false;
+    cnd_signal(&flushWake);
+    mtx_unlock(&flushLock);
+    if (wasRunning)
+        thrd_join(flushThread, NULL);
+    Flush();
+    cnd_destroy(&flushWake);
+    mtx_destroy(&flushLock);
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+// Sahadaki performans ölçümleri: sayaçlar ve log2 kovalı histogramlar.
+// Her iş parçacığı kendi parçasına (shard) kilitsiz yazar; ayrı bir iş parçacığı
+// belirli aralıklarla parçaları toplayıp dönen JSON satırları dosyasına ekler.
+// METRICS_DISABLED tanımlıyken tüm çağrılar boş satır içi fonksiyonlara döner.
+
+#include <stdint.h>
+
+#define METRIC_BUCKETS 32 // Kova b: [2^(b-1), 2^b) aralığı, kova 0 = 0
+
+typedef enum
+{
+    METRIC_FRAME_TIME,        // mikrosaniye
+    METRIC_LOGIC_TIME,        // mikrosaniye, tek mantık adımı
+    METRIC_INPUT_LATENCY,     // mikrosaniye, tıklama -> ilk kare
+    METRIC_CASCADE_DEPTH,     // bir hamledeki kaskad adımı
+    METRIC_DESTROYED_PER_STEP,
+    METRIC_RESHUFFLE_TIME,    // mikrosaniye
+    METRIC_ASSET_LOAD_TIME,   // mikrosaniye
+    METRIC_PARTICLE_TIME,     // mikrosaniye, parçacık güncellemesi
+    METRIC_HISTOGRAM_COUNT
+} MetricHistogram;
+
+typedef enum
+{
+    METRIC_FRAMES,
+    METRIC_TICKS,
+    METRIC_MOVES,
+    METRIC_RESHUFFLES,
+    METRIC_INPUT_DROPPED,
+    METRIC_MATCHES,
+    METRIC_EVENTS_DROPPED, // Yavaş tüketicilerin kaçırdığı olaylar
+    METRIC_COUNTER_COUNT
+} MetricCounter;
+
+typedef struct
+{
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+    uint64_t buckets[METRIC_BUCKETS];
+} MetricHistogramData;
+
+#ifndef METRICS_DISABLED
+
+// path: örn. "metrics.jsonl"; dosya maxBytes'ı geçince path.1, path.2 ... diye döner
+void MetricsInit(const char *path, double flushSeconds, long maxBytes);
+// Son kez yazar ve yazıcı iş parçacığını durdurur
+void MetricsShutdown(void);
+
+void MetricsCount(MetricCounter counter, uint64_t n);
+void MetricsRecord(MetricHistogram histogram, uint64_t value);
+void MetricsRecordSeconds(MetricHistogram histogram, double seconds);
+
+// Tüm parçaların toplamı (yaklaşık anlık görüntü)
+uint64_t MetricsCounter(MetricCounter counter);
+void MetricsRead(MetricHistogram histogram, MetricHistogramData *out);
+
+#else
+
+static inline void MetricsInit(const char *path, double flushSeconds, long maxBytes)
+{
+    (void)path;
+    (void)flushSeconds;
+    (void)maxBytes;
+}
+static inline void MetricsShutdown(void) {}
+static inline void MetricsCount(MetricCounter counter, uint64_t n)
+{
+    (void)counter;
+    (void)n;
+}
+static inline void MetricsRecord(MetricHistogram histogram, uint64_t value)
+{
+    (void)histogram;
+    (void)value;
+}
+static inline void MetricsRecordSeconds(MetricHistogram histogram, double seconds)
+{
+    (void)histogram;
+    (void)seconds;
+}
+static inline uint64_t MetricsCounter(MetricCounter counter)
+{
+    (void)counter;
+    return 0;
+}
+static inline void MetricsRead(MetricHistogram histogram, MetricHistogramData *out)
+{
+    (void)histogram;
+    *out = (MetricHistogramData){ 0 };
+}
+
+#endif
+
+#endif
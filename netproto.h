@@ -0,0 +1,49 @@
+#ifndef NETPROTO_H
+#define NETPROTO_H
+
+// Sunucu ile istemci arasındaki sabit boyutlu ikili mesajlar.
+// Alanlar makinenin bayt sırasıyla gönderilir (şimdilik sadece aynı mimaride).
+
+#include "engine.h"
+
+#define NET_DEFAULT_PORT 7777
+
+typedef enum
+{
+    NET_OP_HELLO = 1, // Oturuma bağlan, yoksa oluştur; ilk mesaj olmalı
+    NET_OP_MOVE = 2,  // Hamle yap
+    NET_OP_STATE = 3  // Sadece tahtayı iste
+} NetOp;
+
+typedef enum
+{
+    NET_STATUS_OK = 0,
+    NET_STATUS_INVALID_MOVE = 1,
+    NET_STATUS_BAD_REQUEST = 2,
+    NET_STATUS_SERVER_FULL = 3 // HELLO reddedildi: işçinin oturum sınırı dolu, bağlantı kapanır
+} NetStatus;
+
+typedef struct
+{
+    uint32_t sessionId;
+    uint8_t op;
+    Move move; // Sadece NET_OP_MOVE için
+    uint8_t reserved[3];
+} NetRequest;
+
+typedef struct
+{
+    uint32_t sessionId;
+    uint8_t op;
+    uint8_t status;
+    uint16_t reserved;
+    int32_t scoreGained;
+    int32_t score;
+    int32_t moves;
+    int8_t type[ROWS][COLS];
+} NetResponse;
+
+_Static_assert(sizeof(NetRequest) == 12, "NetRequest boyutu değişmemeli");
+_Static_assert(sizeof(NetResponse) == 20 + ROWS * COLS, "NetResponse boyutu değişmemeli");
+
+#endif
@@ -0,0 +1,169 @@
+#include "particles.h"
+#include "rlgl.h"
+#include <math.h>
+
+#define PARTICLE_DRAG 2.0f         // Hızın saniyede kaybettiği oran
+#define PARTICLE_DRAW_CHUNK 1024   // rlgl tamponunu taşırmadan tek seferde gönderilen dörtgen
+
+static uint32_t NextRandom(ParticlePool *pool)
+{
+    uint32_t x = pool->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    pool->rng = x;
+    return x;
+}
+
+// [0, 1)
+static float RandomFloat(ParticlePool *pool)
+{
+    return (float)(NextRandom(pool) >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticlesInit(ParticlePool *pool, const char *const *spriteFiles, int spriteFileCount, uint32_t seed)
+{
+    pool->count = 0;
+    pool->rng = seed ? seed : 0x9E3779B9u;
+    if (spriteFileCount > PARTICLE_MAX_SPRITES - 1)
+        spriteFileCount = PARTICLE_MAX_SPRITES - 1;
+    pool->spriteCount = spriteFileCount + 1;
+
+    // Tek satırlık atlas; dosyası olmayan hücreye de kıvılcım kopyalanır
+    const float cell = (float)PARTICLE_ATLAS_CELL;
+    Image atlas = GenImageColor(PARTICLE_ATLAS_CELL * pool->spriteCount, PARTICLE_ATLAS_CELL, BLANK);
+    Image spark = GenImageGradientRadial(PARTICLE_ATLAS_CELL, PARTICLE_ATLAS_CELL, 0.0f, WHITE, BLANK);
+    Rectangle sparkRect = { 0, 0, cell, cell };
+    for (int i = 0; i < pool->spriteCount; i++)
+    {
+        Rectangle target = { cell * i, 0, cell, cell };
+        if (i > 0 && FileExists(spriteFiles[i - 1]))
+        {
+            Image image = LoadImage(spriteFiles[i - 1]);
+            ImageDraw(&atlas, image, (Rectangle){ 0, 0, (float)image.width, (float)image.height }, target, WHITE);
+            UnloadImage(image);
+        }
+        else
+        {
+            ImageDraw(&atlas, spark, sparkRect, target, WHITE);
+        }
+    }
+    pool->atlas = LoadTextureFromImage(atlas);
+    SetTextureFilter(pool->atlas, TEXTURE_FILTER_BILINEAR);
+    UnloadImage(spark);
+    UnloadImage(atlas);
+}
+
+void ParticlesUnload(ParticlePool *pool)
+{
+    UnloadTexture(pool->atlas);
+    pool->count = 0;
+}
+
+int ParticlesEmit(ParticlePool *pool, const ParticleBurst *burst)
+{
+    int n = burst->count;
+    if (n > PARTICLE_CAPACITY - pool->count)
+        n = PARTICLE_CAPACITY - pool->count;
+    int sprite = burst->sprite < pool->spriteCount ? burst->sprite : PARTICLE_SPRITE_SPARK;
+
+    for (int k = 0; k < n; k++)
+    {
+        int i = pool->count++;
+        float angle = RandomFloat(pool) * 2.0f * PI;
+        float speed = burst->speedMin + (burst->speedMax - burst->speedMin) * RandomFloat(pool);
+        float life = burst->life * (0.75f + 0.25f * RandomFloat(pool));
+        pool->x[i] = burst->position.x + burst->spread.x * (2.0f * RandomFloat(pool) - 1.0f);
+        pool->y[i] = burst->position.y + burst->spread.y * (2.0f * RandomFloat(pool) - 1.0f);
+        pool->vx[i] = cosf(angle) * speed;
+        pool->vy[i] = sinf(angle) * speed;
+        pool->gravity[i] = burst->gravity;
+        pool->life[i] = life;
+        pool->fade[i] = 1.0f / life;
+        pool->size[i] = burst->size;
+        pool->color[i] = burst->color;
+        pool->sprite[i] = (uint8_t)sprite;
+    }
+    return n;
+}
+
+// Sıcak döngü: restrict sayesinde takma ad denetimi olmadan vektörleşir
+static void Integrate(int n, float dt, float damping, float *restrict x, float *restrict y,
+    float *restrict vx, float *restrict vy, const float *restrict gravity, float *restrict life)
+{
+    for (int i = 0; i < n; i++)
+    {
+        vx[i] *= damping;
+        vy[i] = vy[i] * damping + gravity[i] * dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        life[i] -= dt;
+    }
+}
+
+void ParticlesUpdate(ParticlePool *pool, float dt)
+{
+    float damping = 1.0f - PARTICLE_DRAG * dt;
+    if (damping < 0.0f)
+        damping = 0.0f;
+    Integrate(pool->count, dt, damping, pool->x, pool->y, pool->vx, pool->vy, pool->gravity, pool->life);
+
+    // Ölenlerin yerine sondakini taşı; sıra önemli değil
+    for (int i = 0; i < pool->count; )
+    {
+        if (pool->life[i] > 0.0f)
+        {
+            i++;
+            continue;
+        }
+        int last = --pool->count;
+        pool->x[i] = pool->x[last];
+        pool->y[i] = pool->y[last];
+        pool->vx[i] = pool->vx[last];
+        pool->vy[i] = pool->vy[last];
+        pool->gravity[i] = pool->gravity[last];
+        pool->life[i] = pool->life[last];
+        pool->fade[i] = pool->fade[last];
+        pool->size[i] = pool->size[last];
+        pool->color[i] = pool->color[last];
+        pool->sprite[i] = pool->sprite[last];
+    }
+}
+
+// Tüm parçacıklar aynı dokudan; rlgl bunları dolana kadar tek çizim çağrısında toplar
+void ParticlesDraw(const ParticlePool *pool)
+{
+    if (pool->count == 0)
+        return;
+    float du = 1.0f / (float)pool->spriteCount;
+
+    rlSetTexture(pool->atlas.id);
+    for (int start = 0; start < pool->count; start += PARTICLE_DRAW_CHUNK)
+    {
+        int end = start + PARTICLE_DRAW_CHUNK < pool->count ? start + PARTICLE_DRAW_CHUNK : pool->count;
+        rlCheckRenderBatchLimit(4 * (end - start));
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (int i = start; i < end; i++)
+        {
+            // Ömür bittikçe küçülür ve saydamlaşır
+            float t = pool->life[i] * pool->fade[i];
+            float half = pool->size[i] * (0.3f + 0.7f * t) * 0.5f;
+            float x = pool->x[i], y = pool->y[i];
+            float u0 = du * pool->sprite[i], u1 = u0 + du;
+            Color c = pool->color[i];
+
+            rlColor4ub(c.r, c.g, c.b, (unsigned char)(c.a * t));
+            rlTexCoord2f(u0, 0.0f);
+            rlVertex2f(x - half, y - half);
+            rlTexCoord2f(u0, 1.0f);
+            rlVertex2f(x - half, y + half);
+            rlTexCoord2f(u1, 1.0f);
+            rlVertex2f(x + half, y + half);
+            rlTexCoord2f(u1, 0.0f);
+            rlVertex2f(x + half, y - half);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
@@ -0,0 +1,61 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+// Sabit kapasiteli parçacık havuzu. Veriler dizi yapısı (SoA) olarak tutulur:
+// güncelleme aynı türden ardışık float dizileri üzerinde dallanmasız döner ve
+// derleyici bunu vektörleştirir. Yaşayanlar [0, count) aralığında sıkışık durur,
+// ölen parçacığın yerine sonuncusu taşınır; çalışırken hiç bellek ayrılmaz.
+// Tümü tek dokulu (atlas) dörtgenler olarak rlgl toplu çizimiyle gönderilir.
+
+#include "raylib.h"
+#include <stdint.h>
+
+#define PARTICLE_CAPACITY 65536
+#define PARTICLE_ATLAS_CELL 32 // Atlastaki her görüntünün kenarı (piksel)
+#define PARTICLE_MAX_SPRITES 16
+#define PARTICLE_SPRITE_SPARK 0 // Üretilen yumuşak beyaz daire, renkle boyanır
+
+typedef struct
+{
+    _Alignas(64) float x[PARTICLE_CAPACITY];
+    _Alignas(64) float y[PARTICLE_CAPACITY];
+    _Alignas(64) float vx[PARTICLE_CAPACITY];
+    _Alignas(64) float vy[PARTICLE_CAPACITY];
+    _Alignas(64) float gravity[PARTICLE_CAPACITY];
+    _Alignas(64) float life[PARTICLE_CAPACITY]; // Kalan saniye
+    _Alignas(64) float fade[PARTICLE_CAPACITY]; // 1 / başlangıç ömrü
+    _Alignas(64) float size[PARTICLE_CAPACITY]; // Başlangıç kenarı (piksel)
+    Color color[PARTICLE_CAPACITY];
+    uint8_t sprite[PARTICLE_CAPACITY];
+    int count;
+    uint32_t rng;
+    Texture2D atlas;
+    int spriteCount;
+} ParticlePool;
+
+// Tek bir patlama: count parçacık, position çevresindeki spread kutusundan
+// rastgele yönlere [speedMin, speedMax] hızla çıkar
+typedef struct
+{
+    Vector2 position;
+    Vector2 spread; // Doğma kutusunun yarı kenarları
+    int count;
+    float speedMin, speedMax;
+    float life;     // Saniye, parçacık başına %25'e kadar kısalır
+    float size;
+    float gravity;  // piksel/s², aşağı pozitif
+    Color color;
+    int sprite;
+} ParticleBurst;
+
+// Atlası kurar: 0 = kıvılcım, i + 1 = spriteFiles[i] (dosya yoksa kıvılcım kullanılır).
+// Pencere açıldıktan sonra çağrılmalı.
+void ParticlesInit(ParticlePool *pool, const char *const *spriteFiles, int spriteFileCount, uint32_t seed);
+void ParticlesUnload(ParticlePool *pool);
+
+// Havuz doluysa sığmayanlar atlanır; eklenen sayıyı döner
+int ParticlesEmit(ParticlePool *pool, const ParticleBurst *burst);
+void ParticlesUpdate(ParticlePool *pool, float dt);
+void ParticlesDraw(const ParticlePool *pool);
+
+#endif
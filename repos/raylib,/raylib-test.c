@@ -4,17 +4,42 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__linux__) && defined(HOT_RELOAD)
+#include <threads.h>
+#include <stdatomic.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
 
 
 #define screenWidth 1366
 #define screenHeight 768
 #define gameWidth 900
 #define gameHeight 1280
+#define renderScale 1.0f //Internal resolution relative to gameWidth x gameHeight, lower it on weak GPUs
 #define gridSize 8
 #define cellSize 100
 #define boardoffsetX 100
 #define boardoffsetY 150
-#define candyTypes 5
+#define candyTypes 6
+#define levelCount 5
+#define maxInputEvents 16
+#define maxTouchPoints 10
+#define saveFile "save.bin"
+#define saveTempFile "save.tmp"
+#define saveMagic 0x56534343u
+#define saveVersion 1
+#define levelsFile "resources/levels.txt"
+#define maxPendingReloads 16
+
+#ifdef _WIN32
+//windows.h clashes with raylib, declare only what we need
+__declspec(dllimport) int __stdcall MoveFileExA(const char* existingName, const char* newName, unsigned long flags);
+#define MOVEFILE_REPLACE_EXISTING 0x1
+#endif
 
 
 
@@ -54,6 +79,20 @@ typedef enum {
 
 }animationState;
 
+//Input event types
+typedef enum {
+	inputPointerDown,
+	inputTouchDown
+}inputType;
+
+//Timestamped pointer/touch event
+typedef struct {
+	inputType type;
+	int pointerId;
+	Vector2 position;
+	double time;
+}inputEvent;
+
 //Level structure
 typedef struct {
 	int targetScore;
@@ -79,7 +118,7 @@ typedef struct {
 typedef struct {
 
 	candyState gameBoard[gridSize][gridSize];
-	levelState levels[5];
+	levelState levels[levelCount];
 	gameState state;
 
 	int score;
@@ -106,6 +145,7 @@ typedef struct {
 	Sound swapSound;
 	Sound matchSound;
 	Sound specialSound;
+	Sound buttonSound;
 
 	Music music;
 
@@ -115,24 +155,181 @@ typedef struct {
 
 gameBoard resources;
 
+//Files under resources/ and where each one is loaded to
+typedef enum {
+	assetTexture,
+	assetSound,
+	assetMusic,
+	assetLevels
+}assetKind;
+
+typedef struct {
+	const char* path;
+	assetKind kind;
+	void* target;
+}assetFile;
+
+assetFile assetFiles[] = {
+	{ "resources/candy0.png", assetTexture, &resources.candyTextures[0] },
+	{ "resources/candy1.png", assetTexture, &resources.candyTextures[1] },
+	{ "resources/candy2.png", assetTexture, &resources.candyTextures[2] },
+	{ "resources/candy3.png", assetTexture, &resources.candyTextures[3] },
+	{ "resources/candy4.png", assetTexture, &resources.candyTextures[4] },
+	{ "resources/candy5.png", assetTexture, &resources.candyTextures[5] },
+	{ "resources/background.png", assetTexture, &resources.backgroundWp },
+	{ "resources/menu.jpg", assetTexture, &resources.menuWp },
+	{ "resources/levels.png", assetTexture, &resources.levelWp },
+	{ "resources/thememusic.mp3", assetMusic, &resources.music },
+	{ "resources/swapSound.mp3", assetSound, &resources.swapSound },
+	{ "resources/matchSound.mp3", assetSound, &resources.matchSound },
+	{ "resources/specialSound.mp3", assetSound, &resources.specialSound },
+	{ "resources/button.mp3", assetSound, &resources.buttonSound },
+	{ levelsFile, assetLevels, resources.levels },
+};
+
+#define assetFileCount (int)(sizeof(assetFiles) / sizeof(assetFiles[0]))
+
+//Binary save data, read back with a single fread
+typedef struct {
+	unsigned int magic;
+	unsigned short version;
+	unsigned short size;
+	signed char boardTypes[gridSize][gridSize];
+	int score;
+	int moves;
+	int currentLevel;
+	float gameTime;
+	bool soundOn;
+	unsigned int checksum;
+}saveData;
+
+unsigned int saveChecksum(const saveData* save) {
+	const unsigned char* bytes = (const unsigned char*)save;
+	unsigned int hash = 2166136261u;
+	for (size_t i = 0; i < offsetof(saveData, checksum); i++) {
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+	return hash;
+}
+
+//Write to a temp file, then rename over the old save
+bool saveGame(void) {
+	saveData save;
+	memset(&save, 0, sizeof(save));
+	save.magic = saveMagic;
+	save.version = saveVersion;
+	save.size = (unsigned short)sizeof(saveData);
+	for (int r = 0; r < gridSize; r++) {
+		for (int c = 0; c < gridSize; c++) {
+			save.boardTypes[r][c] = (signed char)resources.gameBoard[r][c].baseType;
+		}
+	}
+	save.score = resources.score;
+	save.moves = resources.moves;
+	save.currentLevel = resources.currentLevel;
+	save.gameTime = resources.gameTime;
+	save.soundOn = resources.soundOn;
+	save.checksum = saveChecksum(&save);
+
+	FILE* file = fopen(saveTempFile, "wb");
+	if (file == NULL) {
+		return false;
+	}
+	bool written = fwrite(&save, sizeof(save), 1, file) == 1;
+	written = (fclose(file) == 0) && written;
+	if (!written) {
+		return false;
+	}
+#ifdef _WIN32
+	return MoveFileExA(saveTempFile, saveFile, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return rename(saveTempFile, saveFile) == 0;
+#endif
+}
+
+//Restore the last save, false if there is none or it is damaged
+bool loadGame(void) {
+	saveData save;
+	FILE* file = fopen(saveFile, "rb");
+	if (file == NULL) {
+		return false;
+	}
+	bool read = fread(&save, sizeof(save), 1, file) == 1;
+	fclose(file);
+	if (!read || save.magic != saveMagic || save.version != saveVersion ||
+		save.size != sizeof(saveData) || save.checksum != saveChecksum(&save)) {
+		return false;
+	}
+
+	for (int r = 0; r < gridSize; r++) {
+		for (int c = 0; c < gridSize; c++) {
+			resources.gameBoard[r][c].baseType = save.boardTypes[r][c];
+		}
+	}
+	resources.score = save.score;
+	resources.moves = save.moves;
+	resources.currentLevel = save.currentLevel;
+	resources.gameTime = save.gameTime;
+	resources.soundOn = save.soundOn;
+	return true;
+}
+
+//One level per line: targetScore maxMoves timeLimit requiredspecialCandies, # starts a comment
+//Fills levels only if every level was read, so a half saved file keeps the old ones
+bool readLevels(const char* path, levelState* levels) {
+	levelState parsed[levelCount];
+	int count = 0;
+	char line[256];
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		return false;
+	}
+	while (count < levelCount && fgets(line, sizeof(line), file) != NULL) {
+		levelState level;
+		if (line[0] == '#') {
+			continue;
+		}
+		if (sscanf(line, "%d %d %f %d", &level.targetScore, &level.maxMoves, &level.timeLimit, &level.requiredspecialCandies) == 4) {
+			parsed[count++] = level;
+		}
+	}
+	fclose(file);
+	if (count < levelCount) {
+		return false;
+	}
+	memcpy(levels, parsed, sizeof(parsed));
+	return true;
+}
+
+void loadAsset(const assetFile* asset) {
+	switch (asset->kind) {
+	case assetTexture:
+		*(Texture2D*)asset->target = LoadTexture(asset->path);
+		break;
+	case assetSound:
+		*(Sound*)asset->target = LoadSound(asset->path);
+		break;
+	case assetMusic:
+		*(Music*)asset->target = LoadMusicStream(asset->path);
+		break;
+	case assetLevels:
+		if (!readLevels(asset->path, (levelState*)asset->target)) {
+			TraceLog(LOG_WARNING, "Could not read %s", asset->path);
+		}
+		break;
+	}
+}
+
 //Initialize resources
 void initRes() {
 
-	resources.candyTextures[0] = LoadTexture("resources/candy0.png");
-	resources.candyTextures[1] = LoadTexture("resources/candy1.png");
-	resources.candyTextures[2] = LoadTexture("resources/candy2.png");
-	resources.candyTextures[3] = LoadTexture("resources/candy3.png");
-	resources.candyTextures[4] = LoadTexture("resources/candy4.png");
-	resources.candyTextures[5] = LoadTexture("resources/candy5.png");
-	resources.backgroundWp = LoadTexture("resources/background.png");
-	resources.menuWp = LoadTexture("resources/menu.jpg");
-	resources.levelWp = LoadTexture("resources/levels.png");
-	resources.music = LoadMusicStream("resources/thememusic.mp3");
+	for (int i = 0; i < assetFileCount; i++) {
+		loadAsset(&assetFiles[i]);
+	}
 	resources.myFont = LoadFont("resources/font.ttf");
-	resources.swapSound = LoadSound("resources/swapSound.mp3");
-	resources.matchSound = LoadSound("resources/matchSound.mp3");
-	resources.specialSound = LoadSound("resources/specialSound.mp3");
-	resources.soundOn = true;
+	if (!loadGame()) {
+		resources.soundOn = true;
+	}
 
 
 	PlayMusicStream(resources.music);
@@ -140,27 +337,355 @@ void initRes() {
 
 }
 
+#if defined(__linux__) && defined(HOT_RELOAD)
+//Dev builds (-DHOT_RELOAD): files saved under resources/ are decoded on a watcher thread,
+//the main thread only uploads them to the GPU between frames
+typedef struct {
+	int asset;
+	Image image;
+	Wave wave;
+	Music music;
+	levelState levels[levelCount];
+}reloadJob;
+
+reloadJob pendingReloads[maxPendingReloads];
+int pendingReloadCount = 0; //Guarded by reloadLock
+mtx_t reloadLock;
+thrd_t watchThread;
+atomic_bool watching = false;
+int watchFd = -1;
+
+void freereloadJob(reloadJob* job) {
+	if (job->image.data != NULL) {
+		UnloadImage(job->image);
+	}
+	if (job->wave.data != NULL) {
+		UnloadWave(job->wave);
+	}
+	if (job->music.ctxData != NULL) {
+		UnloadMusicStream(job->music);
+	}
+}
+
+//Watcher thread: decode the file, then hand it to the main thread
+void decodeAsset(int asset) {
+	const assetFile* file = &assetFiles[asset];
+	reloadJob job;
+	memset(&job, 0, sizeof(job));
+	job.asset = asset;
+
+	if (file->kind == assetTexture) {
+		job.image = LoadImage(file->path);
+		if (job.image.data == NULL) {
+			return;
+		}
+	}
+	else if (file->kind == assetSound) {
+		job.wave = LoadWave(file->path);
+		if (job.wave.data == NULL) {
+			return;
+		}
+	}
+	else if (file->kind == assetMusic) {
+		//Opening scans the whole file (MP3 frame count), keep it off the main thread;
+		//raylib guards its audio buffer list itself
+		job.music = LoadMusicStream(file->path);
+		if (job.music.ctxData == NULL) {
+			return;
+		}
+	}
+	else if (file->kind == assetLevels && !readLevels(file->path, job.levels)) {
+		return;
+	}
+
+	mtx_lock(&reloadLock);
+	//A newer save of the same file replaces the one not applied yet
+	int slot = pendingReloadCount;
+	for (int i = 0; i < pendingReloadCount; i++) {
+		if (pendingReloads[i].asset == asset) {
+			freereloadJob(&pendingReloads[i]);
+			slot = i;
+		}
+	}
+	if (slot < maxPendingReloads) {
+		pendingReloads[slot] = job;
+		if (slot == pendingReloadCount) {
+			pendingReloadCount++;
+		}
+	}
+	else {
+		freereloadJob(&job);
+	}
+	mtx_unlock(&reloadLock);
+}
+
+int watchResources(void* arg) {
+	(void)arg;
+	_Alignas(struct inotify_event) char buffer[4096];
+	while (atomic_load(&watching)) {
+		//Wake up now and then to notice shutdown
+		struct pollfd pending = { watchFd, POLLIN, 0 };
+		if (poll(&pending, 1, 200) <= 0) {
+			continue;
+		}
+		ssize_t length = read(watchFd, buffer, sizeof(buffer));
+		for (char* p = buffer; length > 0 && p < buffer + length; ) {
+			const struct inotify_event* event = (const struct inotify_event*)p;
+			for (int i = 0; i < assetFileCount && event->len > 0; i++) {
+				const char* name = strrchr(assetFiles[i].path, '/');
+				if (strcmp(name != NULL ? name + 1 : assetFiles[i].path, event->name) == 0) {
+					decodeAsset(i);
+				}
+			}
+			p += sizeof(struct inotify_event) + event->len;
+		}
+	}
+	return 0;
+}
+
+void startHotReload(void) {
+	watchFd = inotify_init1(IN_CLOEXEC);
+	//Editors either write in place or save a copy and rename it over
+	if (watchFd < 0 || inotify_add_watch(watchFd, "resources", IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		TraceLog(LOG_WARNING, "Hot reload disabled, cannot watch resources/");
+		return;
+	}
+	mtx_init(&reloadLock, mtx_plain);
+	atomic_store(&watching, true);
+	if (thrd_create(&watchThread, watchResources, NULL) != thrd_success) {
+		atomic_store(&watching, false);
+	}
+}
+
+//Main thread, between frames: swap in whatever the watcher finished
+void applyHotReload(void) {
+	reloadJob jobs[maxPendingReloads];
+	int count = 0;
+	if (!atomic_load(&watching)) {
+		return;
+	}
+	//Never wait on the watcher, try again next frame
+	if (mtx_trylock(&reloadLock) != thrd_success) {
+		return;
+	}
+	count = pendingReloadCount;
+	memcpy(jobs, pendingReloads, sizeof(reloadJob) * count);
+	pendingReloadCount = 0;
+	mtx_unlock(&reloadLock);
+
+	for (int i = 0; i < count; i++) {
+		const assetFile* file = &assetFiles[jobs[i].asset];
+		if (file->kind == assetTexture) {
+			Texture2D texture = LoadTextureFromImage(jobs[i].image);
+			if (texture.id != 0) {
+				UnloadTexture(*(Texture2D*)file->target);
+				*(Texture2D*)file->target = texture;
+			}
+		}
+		else if (file->kind == assetSound) {
+			Sound sound = LoadSoundFromWave(jobs[i].wave);
+			if (sound.frameCount > 0) {
+				UnloadSound(*(Sound*)file->target);
+				*(Sound*)file->target = sound;
+			}
+		}
+		else if (file->kind == assetMusic) {
+			Music* music = (Music*)file->target;
+			StopMusicStream(*music);
+			UnloadMusicStream(*music);
+			*music = jobs[i].music;
+			jobs[i].music.ctxData = NULL;
+			PlayMusicStream(*music);
+		}
+		else {
+			memcpy(file->target, jobs[i].levels, sizeof(jobs[i].levels));
+		}
+		freereloadJob(&jobs[i]);
+		TraceLog(LOG_INFO, "Reloaded %s", file->path);
+	}
+}
+
+void stopHotReload(void) {
+	if (atomic_exchange(&watching, false)) {
+		thrd_join(watchThread, NULL);
+		for (int i = 0; i < pendingReloadCount; i++) {
+			freereloadJob(&pendingReloads[i]);
+		}
+		pendingReloadCount = 0;
+		mtx_destroy(&reloadLock);
+	}
+	if (watchFd >= 0) {
+		close(watchFd);
+		watchFd = -1;
+	}
+}
+#else
+void startHotReload(void) {}
+void applyHotReload(void) {}
+void stopHotReload(void) {}
+#endif
+
 gameState currentState = MENU;
 
-//Menu 
-void drawmenuScreen(void) {
-	Sound sound;
-	sound = LoadSound("resources/button.mp3");
-	int currentScreenWidth = GetScreenWidth();
-	int currentScreenHeight = GetScreenHeight();
+//Every scene draws in gameWidth x gameHeight units into this target, it is scaled to the window once per frame
+RenderTexture2D gameTarget;
+Camera2D gameCamera;
 
-	float scale = (float)currentScreenHeight / (float)gameHeight;
-	int drawWidth = (int)(gameWidth * scale);
-	int drawHeight = currentScreenHeight;
-	int offsetX = (currentScreenWidth - drawWidth) / 2;
-	int offsetY = 0;
+//Letterboxed placement of the game on screen, recomputed only when the window is resized
+typedef struct {
+	float scale;
+	Rectangle dest;
+	Rectangle window;
+}screenTransform;
+
+screenTransform screenView;
+
+void updatescreenTransform(void) {
+	float scaleX = (float)GetScreenWidth() / (float)gameWidth;
+	float scaleY = (float)GetScreenHeight() / (float)gameHeight;
+	screenView.scale = scaleX < scaleY ? scaleX : scaleY;
+	screenView.dest.width = gameWidth * screenView.scale;
+	screenView.dest.height = gameHeight * screenView.scale;
+	screenView.dest.x = (GetScreenWidth() - screenView.dest.width) / 2.0f;
+	screenView.dest.y = (GetScreenHeight() - screenView.dest.height) / 2.0f;
+	screenView.window = (Rectangle){ 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+}
 
+//Window pixels to game units
+Vector2 screentoGame(Vector2 position) {
+	return (Vector2){ (position.x - screenView.dest.x) / screenView.scale, (position.y - screenView.dest.y) / screenView.scale };
+}
 
-	DrawTexture(resources.backgroundWp, 0, 0, WHITE);
+void initRenderTarget(void) {
+	gameTarget = LoadRenderTexture((int)(gameWidth * renderScale), (int)(gameHeight * renderScale));
+	SetTextureFilter(gameTarget.texture, TEXTURE_FILTER_BILINEAR);
+	gameCamera = (Camera2D){ 0 };
+	gameCamera.zoom = renderScale;
+	updatescreenTransform();
+}
 
-	if (!resources.showSettings) {
-		DrawTexture(resources.backgroundWp, 0, 0, WHITE);
+//Draw the finished frame into the window, the background fills the sides that don't fit
+void presentRenderTarget(void) {
+	DrawTexturePro(resources.backgroundWp,
+		(Rectangle) { 0, 0, (float)resources.backgroundWp.width, (float)resources.backgroundWp.height },
+		screenView.window, (Vector2) { 0, 0 }, 0.0f, WHITE);
+	//Render textures are stored upside down
+	DrawTexturePro(gameTarget.texture,
+		(Rectangle) { 0, 0, (float)gameTarget.texture.width, -(float)gameTarget.texture.height },
+		screenView.dest, (Vector2) { 0, 0 }, 0.0f, WHITE);
+}
+
+//Events collected this frame, handled before drawing
+inputEvent inputEvents[maxInputEvents];
+int inputEventCount = 0;
+
+void pushInput(inputType type, int pointerId, Vector2 position, double time) {
+	if (inputEventCount < maxInputEvents) {
+		inputEvents[inputEventCount++] = (inputEvent){ type, pointerId, screentoGame(position), time };
 	}
+}
+
+//Collect pointer and touch presses once per frame
+void pollInput(void) {
+	static int knownTouchIds[maxTouchPoints];
+	static int knownTouchCount = 0;
+	double now = GetTime();
+	bool touched = false;
+
+	inputEventCount = 0;
+
+	int touchCount = GetTouchPointCount();
+	if (touchCount > maxTouchPoints) {
+		touchCount = maxTouchPoints;
+	}
+	int ids[maxTouchPoints];
+	for (int i = 0; i < touchCount; i++) {
+		ids[i] = GetTouchPointId(i);
+		bool isNew = true;
+		for (int k = 0; k < knownTouchCount; k++) {
+			if (knownTouchIds[k] == ids[i]) {
+				isNew = false;
+			}
+		}
+		if (isNew) {
+			pushInput(inputTouchDown, ids[i], GetTouchPosition(i), now);
+			touched = true;
+		}
+	}
+	memcpy(knownTouchIds, ids, sizeof(int) * touchCount);
+	knownTouchCount = touchCount;
+
+	//Touch is mirrored to the mouse on touch screens, don't count it twice
+	if (!touched && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+		pushInput(inputPointerDown, 0, GetMousePosition(), now);
+	}
+}
+
+//Menu button positions in game units, shared by input handling and drawing
+typedef struct {
+	float centerX;
+	float settingsY;
+	Rectangle playRect;
+	Rectangle settingsRec;
+	Rectangle panel;
+	Rectangle soundToggle;
+	Vector2 closeButtonCenter;
+	float closeButtonRadius;
+}menuLayout;
+
+menuLayout menuButtons;
+
+//Game units don't change with the window, so this runs once
+void initmenuLayout(void) {
+	menuLayout layout;
+	float buttonWidth = 330;
+	float buttonHeight = 100;
+
+	layout.centerX = (gameWidth - buttonWidth) / 2.0f;
+	float playY = gameHeight / 2.0f;
+	layout.settingsY = playY + 165;
+	layout.playRect = (Rectangle){ layout.centerX, playY, buttonWidth, buttonHeight };
+	layout.settingsRec = (Rectangle){ layout.centerX, layout.settingsY, buttonWidth, buttonHeight };
+	layout.panel = (Rectangle){ layout.centerX - 80, layout.settingsY - 250, buttonWidth + 160, 330 };
+	layout.soundToggle = (Rectangle){ layout.panel.x + 100, layout.panel.y + 130, layout.panel.width - 200, 80 };
+	layout.closeButtonCenter = (Vector2){ layout.panel.x + layout.panel.width - 50, layout.panel.y - 50 };
+	layout.closeButtonRadius = 40;
+	menuButtons = layout;
+}
+
+//Menu input, handled before the frame is drawn
+void updatemenuScreen(void) {
+	const menuLayout layout = menuButtons;
+
+	for (int i = 0; i < inputEventCount; i++) {
+		Vector2 mouse = inputEvents[i].position;
+
+		if (CheckCollisionPointRec(mouse, layout.playRect) && !resources.showSettings) {
+			currentState = LEVELS;
+		}
+		if (CheckCollisionPointRec(mouse, layout.settingsRec)) {
+			resources.showSettings = true;
+		}
+		if (CheckCollisionPointRec(mouse, layout.playRect)) {
+			PlaySound(resources.buttonSound);
+		}
+
+		if (resources.showSettings) {
+			if (CheckCollisionPointCircle(mouse, layout.closeButtonCenter, layout.closeButtonRadius)) {
+				resources.showSettings = false;
+			}
+			if (CheckCollisionPointRec(mouse, layout.soundToggle)) {
+				resources.soundOn = !resources.soundOn;
+				SetMasterVolume(resources.soundOn ? 1.0f : 0.0f);
+				saveGame();
+			}
+		}
+	}
+}
+
+//Menu 
+void drawmenuScreen(void) {
+	const menuLayout layout = menuButtons;
 
 	DrawTexturePro(
 		resources.menuWp,
@@ -168,39 +693,30 @@ void drawmenuScreen(void) {
 		0, 0, (float)resources.menuWp.width, (float)resources.menuWp.height
 	},
 		(Rectangle) {
-		offsetX, offsetY, drawWidth, drawHeight
+		0, 0, gameWidth, gameHeight
 	},
 		(Vector2) {
 		0, 0
 	}, 0.0f, WHITE);
 
 
-	Font myFont = LoadFont("resources/font.ttf");
-	float buttonWidth = 200;
-	float buttonHeight = 60;
-	float posX = (screenWidth - buttonWidth) / 2;
-	float posY = (screenHeight - buttonHeight) / 2;
-
-	float fontSize = 25;
+	Font myFont = resources.myFont;
+	float fontSize = 40;
 	float spacing = 2;
-	float centerX = (currentScreenWidth - buttonWidth) / 2.0f;
-
 
-	float playY = currentScreenHeight / 2.0f;
-	Rectangle playRect = { centerX, playY, buttonWidth, buttonHeight };
+	Rectangle playRect = layout.playRect;
 	Vector2 playTextSize = MeasureTextEx(myFont, "Play", fontSize, spacing);
 	Vector2 playTextPos = {
-		centerX + (buttonWidth - playTextSize.x) / 2.0f,
-		playY + (buttonHeight - playTextSize.y) / 2.0f
+		playRect.x + (playRect.width - playTextSize.x) / 2.0f,
+		playRect.y + (playRect.height - playTextSize.y) / 2.0f
 	};
 
 
-	float settingsY = playY + 100;
-	Rectangle settingsRec = { centerX, settingsY, buttonWidth, buttonHeight };
+	Rectangle settingsRec = layout.settingsRec;
 	Vector2 settingsTextSize = MeasureTextEx(myFont, "Settings", fontSize, spacing);
 	Vector2 settingsTextPos = {
-		centerX + (buttonWidth - settingsTextSize.x) / 2.0f,
-		settingsY + (buttonHeight - settingsTextSize.y) / 2.0f
+		settingsRec.x + (settingsRec.width - settingsTextSize.x) / 2.0f,
+		settingsRec.y + (settingsRec.height - settingsTextSize.y) / 2.0f
 	};
 
 
@@ -212,28 +728,13 @@ void drawmenuScreen(void) {
 
 	DrawTextEx(myFont, "Settings", settingsTextPos, fontSize, spacing, BLACK);
 
-	if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-		Vector2 mouseposS = GetMousePosition();
-		if (CheckCollisionPointRec(mouseposS, playRect) && !resources.showSettings) {
-			currentState = LEVELS;
-		}
-		if (CheckCollisionPointRec(mouseposS, settingsRec)) {
-			resources.showSettings = true;
-		}
-		if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-			if (CheckCollisionPointRec(GetMousePosition(), playRect)) {
-				PlaySound(sound);
-			}
-		}
-	}
-
 
 	if (resources.showSettings) {
 
-		DrawRectangle(0, 0, currentScreenWidth, currentScreenHeight, Fade(BLACK, 0.8f));
+		DrawRectangle(0, 0, gameWidth, gameHeight, Fade(BLACK, 0.8f));
 
 
-		Rectangle panel = { centerX - 50, settingsY - 150, buttonWidth + 100, 200 };
+		Rectangle panel = layout.panel;
 		DrawRectangleRounded(panel, 10, 10, ORANGE);
 
 
@@ -241,72 +742,44 @@ void drawmenuScreen(void) {
 		Vector2 soundSize = MeasureTextEx(myFont, soundToggleText, fontSize, spacing);
 		Vector2 soundPos = {
 			panel.x + (panel.width - soundSize.x) / 2,
-			panel.y + 30
+			panel.y + 50
 		};
 		DrawTextEx(myFont, soundToggleText, soundPos, fontSize, spacing, BLACK);
 
-		Rectangle soundToggle = { panel.x + 60, panel.y + 80, panel.width - 120, 50 };
+		Rectangle soundToggle = layout.soundToggle;
 		DrawRectangleRounded(soundToggle, 0.3f, 10, PINK);
-		DrawTextEx(myFont, "Toggle Sound", (Vector2) { soundToggle.x + 10, soundToggle.y + 10 },
+		DrawTextEx(myFont, "Toggle Sound", (Vector2) { soundToggle.x + 16, soundToggle.y + 20 },
 			fontSize, spacing, BLACK);
 
 
-		Vector2 closeButtonCenter = { panel.x + panel.width - 30, panel.y - 30 };
-		float closeButtonRadius = 25;
+		Vector2 closeButtonCenter = layout.closeButtonCenter;
+		float closeButtonRadius = layout.closeButtonRadius;
 		DrawCircleV(closeButtonCenter, closeButtonRadius, DARKGRAY);
-		DrawTextEx(myFont, "X", (Vector2) { closeButtonCenter.x - 8, closeButtonCenter.y - 12 }, 30, spacing, WHITE);
-
-
-		if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-			Vector2 mouse = GetMousePosition();
-			if (CheckCollisionPointCircle(mouse, closeButtonCenter, closeButtonRadius)) {
-				resources.showSettings = false;
-			}
-		}
-
-
-		if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-			Vector2 mouse = GetMousePosition();
-			if (CheckCollisionPointRec(mouse, soundToggle)) {
-				resources.soundOn = !resources.soundOn;
-				SetMasterVolume(resources.soundOn ? 1.0f : 0.0f);
-			}
-		}
+		DrawTextEx(myFont, "X", (Vector2) { closeButtonCenter.x - 13, closeButtonCenter.y - 20 }, 48, spacing, WHITE);
 	}
 }
 
 
 
 void drawlevelScreen(void) {
-	int currentScreenWidth = GetScreenWidth();
-	int currentScreenHeight = GetScreenHeight();
-
-	float scale = (float)currentScreenHeight / (float)gameHeight;
-	int drawWidth = (int)(gameWidth * scale);
-	int drawHeight = currentScreenHeight;
-	int offsetX = (currentScreenWidth - drawWidth) / 2;
-	int offsetY = 0;
-
-	DrawTexture(resources.backgroundWp, 0, 0, WHITE);
-
 	DrawTexturePro(
 		resources.levelWp,
 		(Rectangle) {
 		0, 0, (float)resources.levelWp.width, (float)resources.levelWp.height
 	},
 		(Rectangle) {
-		offsetX, offsetY, drawWidth, drawHeight
+		0, 0, gameWidth, gameHeight
 	},
 		(Vector2) {
 		0, 0
 	}, 0.0f, WHITE
 	);
 
-	int buttonRadius = 40;
-	int buttonSpacing = 30;
+	int buttonRadius = 64;
+	int buttonSpacing = 48;
 	int totalHeight = 5 * buttonRadius * 2 + 4 * buttonSpacing;
-	int startY = (currentScreenHeight - totalHeight) / 2 + buttonRadius;
-	int centerX = currentScreenWidth / 2;
+	int startY = (gameHeight - totalHeight) / 2 + buttonRadius;
+	int centerX = gameWidth / 2;
 
 	for (int i = 0; i < 5; i++) {
 		int levelNum = 5 - i;
@@ -317,7 +790,7 @@ void drawlevelScreen(void) {
 		char label[2];
 		snprintf(label, sizeof(label), "%d", levelNum);
 
-		int fontSize = 32;
+		int fontSize = 52;
 		int textWidth = MeasureText(label, fontSize);
 		int textHeight = fontSize;
 		DrawText(label, centerX - textWidth / 2, cy - textHeight / 2, fontSize, BLACK);
@@ -339,6 +812,7 @@ void ToggleSound() {
 	else {
 		SetMasterVolume(0.0f);
 	}
+	saveGame();
 }
 
 void settings(void) {
@@ -362,6 +836,7 @@ void unloadRes(void) {
 	UnloadTexture(resources.menuWp);
 	UnloadTexture(resources.levelWp);
 	UnloadMusicStream(resources.music);
+	UnloadSound(resources.buttonSound);
 	UnloadFont(resources.myFont);
 }
 
@@ -388,12 +863,18 @@ int main() {
 	//Initialize sound
 	InitAudioDevice();
 	initRes();
+	startHotReload();
+	initRenderTarget();
+	initmenuLayout();
 
 	currentState = MENU;
 
 	//Main loop 
 	while (!WindowShouldClose()) {
 
+		//Reloaded files are swapped in before anything uses them this frame
+		applyHotReload();
+
 		UpdateMusicStream(resources.music);
 
 		if (!IsMusicStreamPlaying(resources.music) && resources.soundOn) {
@@ -401,8 +882,18 @@ int main() {
 			PlayMusicStream(resources.music);
 		}
 
+		if (IsWindowResized()) {
+			updatescreenTransform();
+		}
+
+		//Input is handled before drawing
+		pollInput();
+		if (currentState == MENU) {
+			updatemenuScreen();
+		}
 
-		BeginDrawing();
+		BeginTextureMode(gameTarget);
+		BeginMode2D(gameCamera);
 		ClearBackground(RAYWHITE);
 
 		switch (currentState) {
@@ -415,10 +906,18 @@ int main() {
 			break;
 		}
 
+		EndMode2D();
+		EndTextureMode();
+
+		BeginDrawing();
+		presentRenderTarget();
 		EndDrawing();
 
 	}
 
+	saveGame();
+	stopHotReload();
+	UnloadRenderTexture(gameTarget);
 	CloseWindow();
 	return 0;
 
@@ -0,0 +1,717 @@
+// Başsız turnuva sunucusu: birçok bağımsız tahta oturumunu barındırır.
+// Oturumlar kimliklerine göre işçi iş parçacıklarına bölünür (id % işçi sayısı).
+// Her işçi kendi epoll döngüsünde bağlantılarını ve oturumlarını kilitsiz yönetir;
+// ana iş parçacığı bağlantıları kabul edip HELLO mesajına göre doğru işçiye verir.
+//
+// Derleme (Linux): cc -O2 -std=c11 server.c engine.c arena.c eventbus.c -o server -lpthread
+// Kullanım: ./server [--port 7777] [--workers 4] [--seed 1] [--max-sessions 65536] [--idle-timeout 60]
+//
+// Bağlantısı kalmayan oturum yeniden bağlanmak için --idle-timeout saniye saklanır, sonra silinir.
+// İşçi başına en çok --max-sessions oturum; doluysa en eski boştaki oturum silinir,
+// o da yoksa HELLO NET_STATUS_SERVER_FULL ile reddedilir.
+// HELLO'yu HELLO_TIMEOUT saniyede göndermeyen bağlantı kapatılır.
+
+#define _GNU_SOURCE
+#include "engine.h"
+#include "netproto.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#define MAX_WORKERS 64
+#define MAX_EVENTS 256
+#define MAX_REQUESTS_PER_READ 64 // Bir uyanışta bağlantı başına iş sınırı (kuyruk gecikmesi için)
+#define IN_BUFFER_SIZE (MAX_REQUESTS_PER_READ * sizeof(NetRequest))
+#define OUT_BUFFER_SIZE (MAX_REQUESTS_PER_READ * sizeof(NetResponse))
+#define STATS_INTERVAL 5.0
+#define HELLO_TIMEOUT 5.0
+
+typedef struct Session
+{
+    uint32_t id;
+    int connections;
+    double idleSince;                    // Son bağlantının kapandığı an
+    struct Session *idlePrev, *idleNext; // Bağlantısız oturumlar, en eski başta
+    Engine engine;
+} Session;
+
+// Açık adresli oturum tablosu; oturumlar ayrı ayrılır, işaretçiler büyümede geçerli kalır
+typedef struct
+{
+    Session **slots;
+    size_t capacity;
+    size_t count;
+    Session *idleHead, *idleTail;
+} SessionTable;
+
+typedef struct
+{
+    int fd;
+    Session *session;
+    unsigned char in[IN_BUFFER_SIZE];
+    size_t inLen;
+    unsigned char out[OUT_BUFFER_SIZE];
+    size_t outLen, outSent;
+    bool writing; // EPOLLOUT bekleniyor
+} Connection;
+
+// Kabul edilip HELLO'su okunmuş, işçiye devredilecek bağlantı
+typedef struct Handoff
+{
+    int fd;
+    NetRequest hello;
+    struct Handoff *next;
+} Handoff;
+
+typedef struct
+{
+    int index;
+    int epollFd;
+    int wakeFd;
+    mtx_t handoffLock;
+    Handoff *handoffs;
+    SessionTable sessions;
+    atomic_ullong requests;
+    atomic_ullong invalidMoves;
+    atomic_ullong rejected;
+    atomic_uint sessionCount;
+} Worker;
+
+// HELLO'su henüz tamamlanmamış bağlantı
+typedef struct PendingConnection
+{
+    int fd;
+    NetRequest hello;
+    size_t len;
+    double acceptedAt;
+    struct PendingConnection *prev, *next; // Kabul sırasıyla, en eski başta
+} PendingConnection;
+
+static Worker workers[MAX_WORKERS];
+static int workerCount = 4;
+static uint64_t serverSeed = 1;
+static size_t maxSessions = 65536; // İşçi başına
+static double idleTimeout = 60.0;
+static atomic_bool running = true;
+
+// Sadece kabul iş parçacığı
+static PendingConnection *pendingHead, *pendingTail;
+static unsigned long long helloTimeouts;
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void OnSignal(int sig)
+{
+    (void)sig;
+    atomic_store(&running, false);
+}
+
+static bool SetNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+static uint64_t HashId(uint32_t id)
+{
+    uint64_t h = id * 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 29);
+}
+
+static Session **SessionSlot(SessionTable *t, uint32_t id)
+{
+    size_t mask = t->capacity - 1;
+    size_t i = (size_t)HashId(id) & mask;
+    while (t->slots[i] != NULL && t->slots[i]->id != id)
+        i = (i + 1) & mask;
+    return &t->slots[i];
+}
+
+static bool SessionTableGrow(SessionTable *t)
+{
+    size_t capacity = t->capacity ? t->capacity * 2 : 1024;
+    Session **old = t->slots;
+    size_t oldCapacity = t->capacity;
+    t->slots = calloc(capacity, sizeof(Session *));
+    if (t->slots == NULL)
+    {
+        t->slots = old;
+        return false;
+    }
+    t->capacity = capacity;
+    for (size_t i = 0; i < oldCapacity; i++)
+        if (old[i] != NULL)
+            *SessionSlot(t, old[i]->id) = old[i];
+    free(old);
+    return true;
+}
+
+static void IdleUnlink(SessionTable *t, Session *s)
+{
+    if (s->idlePrev != NULL)
+        s->idlePrev->idleNext = s->idleNext;
+    else
+        t->idleHead = s->idleNext;
+    if (s->idleNext != NULL)
+        s->idleNext->idlePrev = s->idlePrev;
+    else
+        t->idleTail = s->idlePrev;
+    s->idlePrev = s->idleNext = NULL;
+}
+
+// Oturumu tablodan sil; aynı kümedeki sonraki girişler yeniden yerleştirilir (doğrusal yoklama)
+static void SessionRemove(SessionTable *t, Session *s)
+{
+    size_t mask = t->capacity - 1;
+    Session **slot = SessionSlot(t, s->id);
+    size_t i = (size_t)(slot - t->slots);
+    t->slots[i] = NULL;
+    for (size_t j = (i + 1) & mask; t->slots[j] != NULL; j = (j + 1) & mask)
+    {
+        Session *moved = t->slots[j];
+        t->slots[j] = NULL;
+        *SessionSlot(t, moved->id) = moved;
+    }
+    IdleUnlink(t, s);
+    free(s);
+    t->count--;
+}
+
+// Süresi dolan bağlantısız oturumları sil; liste en eskiden sıralı olduğundan baştan bakmak yeter
+static void SessionEvictIdle(SessionTable *t, double now)
+{
+    while (t->idleHead != NULL && now - t->idleHead->idleSince >= idleTimeout)
+        SessionRemove(t, t->idleHead);
+}
+
+// Oturumu bul, yoksa kimliğinden türetilen tohumla yeni tahta aç; bağlantı sayısını artırır.
+// Sınır doluysa ve silinecek bağlantısız oturum yoksa NULL.
+static Session *SessionGet(SessionTable *t, uint32_t id)
+{
+    Session **slot = SessionSlot(t, id);
+    if (*slot == NULL)
+    {
+        if (t->count >= maxSessions)
+        {
+            if (t->idleHead == NULL)
+                return NULL;
+            SessionRemove(t, t->idleHead);
+        }
+        if ((t->count + 1) * 2 > t->capacity && !SessionTableGrow(t))
+            return NULL;
+        slot = SessionSlot(t, id);
+        Session *s = malloc(sizeof(Session));
+        if (s == NULL)
+            return NULL;
+        s->id = id;
+        s->connections = 0;
+        s->idlePrev = s->idleNext = NULL;
+        EngineInit(&s->engine, serverSeed ^ HashId(id));
+        *slot = s;
+        t->count++;
+    }
+    Session *s = *slot;
+    if (s->connections++ == 0 && (t->idleHead == s || s->idlePrev != NULL))
+        IdleUnlink(t, s);
+    return s;
+}
+
+// Son bağlantı kapandıysa oturumu boşta listesinin sonuna ekle
+static void SessionRelease(SessionTable *t, Session *s, double now)
+{
+    if (--s->connections > 0)
+        return;
+    s->idleSince = now;
+    s->idlePrev = t->idleTail;
+    s->idleNext = NULL;
+    if (t->idleTail != NULL)
+        t->idleTail->idleNext = s;
+    else
+        t->idleHead = s;
+    t->idleTail = s;
+}
+
+static void CloseConnection(Worker *w, Connection *c)
+{
+    epoll_ctl(w->epollFd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    SessionRelease(&w->sessions, c->session, Now());
+    free(c);
+}
+
+// Oturum açılamadı: tek yanıt gönder ve kapat (yeni soketin tamponu boş, send beklemez)
+static void RejectHello(Worker *w, int fd, const NetRequest *hello)
+{
+    NetResponse res;
+    memset(&res, 0, sizeof(res));
+    res.sessionId = hello->sessionId;
+    res.op = hello->op;
+    res.status = NET_STATUS_SERVER_FULL;
+    if (send(fd, &res, sizeof(res), MSG_NOSIGNAL) < 0)
+        perror("send");
+    close(fd);
+    atomic_fetch_add_explicit(&w->rejected, 1, memory_order_relaxed);
+}
+
+static void UpdateInterest(Worker *w, Connection *c, bool writing)
+{
+    if (c->writing == writing)
+        return;
+    // Gönderilmemiş yanıt varken yeni istek okuma: istemci okumuyorsa geri basınç
+    struct epoll_event ev = { .events = writing ? EPOLLOUT : EPOLLIN, .data.ptr = c };
+    epoll_ctl(w->epollFd, EPOLL_CTL_MOD, c->fd, &ev);
+    c->writing = writing;
+}
+
+// Bekleyen yanıtları yaz; hepsi gittiyse true
+static bool FlushConnection(Connection *c, bool *failed)
+{
+    while (c->outSent < c->outLen)
+    {
+        ssize_t n = send(c->fd, c->out + c->outSent, c->outLen - c->outSent, MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return false;
+            if (errno == EINTR)
+                continue;
+            *failed = true;
+            return false;
+        }
+        c->outSent += (size_t)n;
+    }
+    c->outLen = 0;
+    c->outSent = 0;
+    return true;
+}
+
+static void WriteResponse(Connection *c, const NetRequest *req, NetStatus status, int gained)
+{
+    NetResponse res;
+    const Engine *e = &c->session->engine;
+    res.sessionId = c->session->id;
+    res.op = req->op;
+    res.status = (uint8_t)status;
+    res.reserved = 0;
+    res.scoreGained = gained;
+    res.score = e->score;
+    res.moves = e->moves;
+    for (int r = 0; r < ROWS; r++)
+        memcpy(res.type[r], e->type[r], sizeof(res.type[r]));
+    memcpy(c->out + c->outLen, &res, sizeof(res));
+    c->outLen += sizeof(res);
+}
+
+// Tamponlanmış istekleri sırayla işle; hamleler sunucuda doğrulanır
+static void ProcessRequests(Worker *w, Connection *c)
+{
+    size_t offset = 0;
+    while (c->inLen - offset >= sizeof(NetRequest) && c->outLen + sizeof(NetResponse) <= OUT_BUFFER_SIZE)
+    {
+        NetRequest req;
+        memcpy(&req, c->in + offset, sizeof(req));
+        offset += sizeof(req);
+
+        if (req.sessionId != c->session->id)
+        {
+            WriteResponse(c, &req, NET_STATUS_BAD_REQUEST, 0);
+        }
+        else if (req.op == NET_OP_MOVE)
+        {
+            int gained = EngineApplyMove(&c->session->engine, req.move);
+            if (gained < 0)
+                atomic_fetch_add_explicit(&w->invalidMoves, 1, memory_order_relaxed);
+            WriteResponse(c, &req, gained < 0 ? NET_STATUS_INVALID_MOVE : NET_STATUS_OK, gained < 0 ? 0 : gained);
+        }
+        else if (req.op == NET_OP_STATE || req.op == NET_OP_HELLO)
+        {
+            WriteResponse(c, &req, NET_STATUS_OK, 0);
+        }
+        else
+        {
+            WriteResponse(c, &req, NET_STATUS_BAD_REQUEST, 0);
+        }
+        atomic_fetch_add_explicit(&w->requests, 1, memory_order_relaxed);
+    }
+    memmove(c->in, c->in + offset, c->inLen - offset);
+    c->inLen -= offset;
+}
+
+static void OnReadable(Worker *w, Connection *c)
+{
+    ssize_t n = recv(c->fd, c->in + c->inLen, IN_BUFFER_SIZE - c->inLen, 0);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+    {
+        CloseConnection(w, c);
+        return;
+    }
+    if (n > 0)
+        c->inLen += (size_t)n;
+
+    ProcessRequests(w, c);
+    bool failed = false;
+    bool flushed = FlushConnection(c, &failed);
+    if (failed)
+        CloseConnection(w, c);
+    else
+        UpdateInterest(w, c, !flushed);
+}
+
+static void OnWritable(Worker *w, Connection *c)
+{
+    bool failed = false;
+    if (!FlushConnection(c, &failed))
+    {
+        if (failed)
+            CloseConnection(w, c);
+        return;
+    }
+    // Yazma bitti, okunmuş ama işlenmemiş istekler varsa devam et
+    ProcessRequests(w, c);
+    bool flushed = FlushConnection(c, &failed);
+    if (failed)
+        CloseConnection(w, c);
+    else
+        UpdateInterest(w, c, !flushed);
+}
+
+// Ana iş parçacığından devredilen bağlantıları al
+static void AcceptHandoffs(Worker *w)
+{
+    uint64_t value;
+    if (read(w->wakeFd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+        perror("eventfd");
+
+    mtx_lock(&w->handoffLock);
+    Handoff *list = w->handoffs;
+    w->handoffs = NULL;
+    mtx_unlock(&w->handoffLock);
+
+    while (list != NULL)
+    {
+        Handoff *h = list;
+        list = h->next;
+
+        Connection *c = malloc(sizeof(Connection));
+        Session *s = c != NULL ? SessionGet(&w->sessions, h->hello.sessionId) : NULL;
+        if (c == NULL || s == NULL)
+        {
+            free(c);
+            RejectHello(w, h->fd, &h->hello);
+            free(h);
+            continue;
+        }
+        c->fd = h->fd;
+        c->session = s;
+        c->inLen = 0;
+        c->outLen = 0;
+        c->outSent = 0;
+        c->writing = false;
+        atomic_store_explicit(&w->sessionCount, (unsigned)w->sessions.count, memory_order_relaxed);
+
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = c };
+        if (epoll_ctl(w->epollFd, EPOLL_CTL_ADD, c->fd, &ev) < 0)
+        {
+            close(c->fd);
+            SessionRelease(&w->sessions, s, Now());
+            free(c);
+            free(h);
+            continue;
+        }
+        WriteResponse(c, &h->hello, NET_STATUS_OK, 0);
+        bool failed = false;
+        bool flushed = FlushConnection(c, &failed);
+        if (failed)
+            CloseConnection(w, c);
+        else
+            UpdateInterest(w, c, !flushed);
+        free(h);
+    }
+}
+
+static int WorkerThread(void *arg)
+{
+    Worker *w = arg;
+    struct epoll_event events[MAX_EVENTS];
+    while (atomic_load_explicit(&running, memory_order_relaxed))
+    {
+        int n = epoll_wait(w->epollFd, events, MAX_EVENTS, 500);
+        for (int i = 0; i < n; i++)
+        {
+            if (events[i].data.ptr == NULL)
+            {
+                AcceptHandoffs(w);
+                continue;
+            }
+            Connection *c = events[i].data.ptr;
+            if (events[i].events & (EPOLLERR | EPOLLHUP))
+                CloseConnection(w, c);
+            else if (events[i].events & EPOLLOUT)
+                OnWritable(w, c);
+            else if (events[i].events & EPOLLIN)
+                OnReadable(w, c);
+        }
+        SessionEvictIdle(&w->sessions, Now());
+        atomic_store_explicit(&w->sessionCount, (unsigned)w->sessions.count, memory_order_relaxed);
+    }
+    return 0;
+}
+
+static bool StartWorker(Worker *w, int index, thrd_t *thread)
+{
+    memset(w, 0, sizeof(*w));
+    w->index = index;
+    w->epollFd = epoll_create1(0);
+    w->wakeFd = eventfd(0, EFD_NONBLOCK);
+    if (w->epollFd < 0 || w->wakeFd < 0 || mtx_init(&w->handoffLock, mtx_plain) != thrd_success)
+        return false;
+    if (!SessionTableGrow(&w->sessions))
+        return false;
+    struct epoll_event ev = { .events = EPOLLIN, .data.ptr = NULL };
+    if (epoll_ctl(w->epollFd, EPOLL_CTL_ADD, w->wakeFd, &ev) < 0)
+        return false;
+    return thrd_create(thread, WorkerThread, w) == thrd_success;
+}
+
+static void PendingAppend(PendingConnection *p)
+{
+    p->prev = pendingTail;
+    p->next = NULL;
+    if (pendingTail != NULL)
+        pendingTail->next = p;
+    else
+        pendingHead = p;
+    pendingTail = p;
+}
+
+// Listeden çıkar, epoll'dan sil ve serbest bırak; soket çağıranda kalır
+static int PendingRemove(int epollFd, PendingConnection *p)
+{
+    if (p->prev != NULL)
+        p->prev->next = p->next;
+    else
+        pendingHead = p->next;
+    if (p->next != NULL)
+        p->next->prev = p->prev;
+    else
+        pendingTail = p->prev;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, p->fd, NULL);
+    int fd = p->fd;
+    free(p);
+    return fd;
+}
+
+// Süre sabit olduğundan liste kabul sırasıyla sıralı; baştan bakmak yeter
+static void PendingExpire(int epollFd, double now)
+{
+    while (pendingHead != NULL && now - pendingHead->acceptedAt >= HELLO_TIMEOUT)
+    {
+        close(PendingRemove(epollFd, pendingHead));
+        helloTimeouts++;
+    }
+}
+
+static void HandOff(int fd, const NetRequest *hello)
+{
+    Worker *w = &workers[hello->sessionId % (uint32_t)workerCount];
+    Handoff *h = malloc(sizeof(Handoff));
+    if (h == NULL)
+    {
+        close(fd);
+        return;
+    }
+    h->fd = fd;
+    h->hello = *hello;
+    mtx_lock(&w->handoffLock);
+    h->next = w->handoffs;
+    w->handoffs = h;
+    mtx_unlock(&w->handoffLock);
+    uint64_t one = 1;
+    if (write(w->wakeFd, &one, sizeof(one)) < 0)
+        perror("eventfd");
+}
+
+static int OpenListener(int port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 4096) < 0 || !SetNonBlocking(fd))
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void PrintStats(double elapsed, unsigned long long *lastRequests)
+{
+    unsigned long long requests = 0, invalid = 0, rejected = 0;
+    unsigned sessions = 0;
+    for (int i = 0; i < workerCount; i++)
+    {
+        requests += atomic_load_explicit(&workers[i].requests, memory_order_relaxed);
+        invalid += atomic_load_explicit(&workers[i].invalidMoves, memory_order_relaxed);
+        rejected += atomic_load_explicit(&workers[i].rejected, memory_order_relaxed);
+        sessions += atomic_load_explicit(&workers[i].sessionCount, memory_order_relaxed);
+    }
+    if (requests != *lastRequests)
+        printf("oturum %u, istek/s %.0f, toplam istek %llu, geçersiz hamle %llu, reddedilen bağlantı %llu, HELLO zaman aşımı %llu\n",
+            sessions, (double)(requests - *lastRequests) / elapsed, requests, invalid, rejected, helloTimeouts);
+    *lastRequests = requests;
+}
+
+int main(int argc, char **argv)
+{
+    int port = NET_DEFAULT_PORT;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (strcmp(argv[i], "--port") == 0)
+            port = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--workers") == 0)
+            workerCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0)
+            serverSeed = strtoull(argv[i + 1], NULL, 10);
+        else if (strcmp(argv[i], "--max-sessions") == 0)
+            maxSessions = strtoull(argv[i + 1], NULL, 10);
+        else if (strcmp(argv[i], "--idle-timeout") == 0)
+            idleTimeout = atof(argv[i + 1]);
+    }
+    if (workerCount < 1 || workerCount > MAX_WORKERS)
+    {
+        fprintf(stderr, "--workers 1..%d olmalı\n", MAX_WORKERS);
+        return 1;
+    }
+    if (maxSessions < 1)
+    {
+        fprintf(stderr, "--max-sessions en az 1 olmalı\n");
+        return 1;
+    }
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    int listener = OpenListener(port);
+    if (listener < 0)
+    {
+        perror("dinleme soketi");
+        return 1;
+    }
+
+    thrd_t threads[MAX_WORKERS];
+    for (int i = 0; i < workerCount; i++)
+    {
+        if (!StartWorker(&workers[i], i, &threads[i]))
+        {
+            fprintf(stderr, "işçi %d başlatılamadı\n", i);
+            return 1;
+        }
+    }
+
+    // Kabul döngüsü: HELLO gelene kadar bağlantı burada bekler
+    int epollFd = epoll_create1(0);
+    struct epoll_event ev = { .events = EPOLLIN, .data.ptr = NULL };
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listener, &ev);
+    printf("sunucu :%d portunda, %d işçi\n", port, workerCount);
+
+    struct epoll_event events[MAX_EVENTS];
+    double lastStats = Now();
+    unsigned long long lastRequests = 0;
+    while (atomic_load(&running))
+    {
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, 500);
+        for (int i = 0; i < n; i++)
+        {
+            if (events[i].data.ptr == NULL)
+            {
+                int fd;
+                while ((fd = accept(listener, NULL, NULL)) >= 0)
+                {
+                    int one = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                    PendingConnection *p = calloc(1, sizeof(PendingConnection));
+                    if (p == NULL || !SetNonBlocking(fd))
+                    {
+                        free(p);
+                        close(fd);
+                        continue;
+                    }
+                    p->fd = fd;
+                    p->acceptedAt = Now();
+                    struct epoll_event pev = { .events = EPOLLIN, .data.ptr = p };
+                    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &pev) < 0)
+                    {
+                        free(p);
+                        close(fd);
+                        continue;
+                    }
+                    PendingAppend(p);
+                }
+                continue;
+            }
+
+            PendingConnection *p = events[i].data.ptr;
+            ssize_t got = recv(p->fd, (unsigned char *)&p->hello + p->len, sizeof(NetRequest) - p->len, 0);
+            if (got <= 0 && !(got < 0 && (errno == EAGAIN || errno == EINTR)))
+            {
+                close(PendingRemove(epollFd, p));
+                continue;
+            }
+            if (got > 0)
+                p->len += (size_t)got;
+            if (p->len == sizeof(NetRequest))
+            {
+                NetRequest hello = p->hello;
+                int fd = PendingRemove(epollFd, p);
+                if (hello.op == NET_OP_HELLO)
+                    HandOff(fd, &hello);
+                else
+                    close(fd);
+            }
+        }
+
+        double now = Now();
+        PendingExpire(epollFd, now);
+        if (now - lastStats >= STATS_INTERVAL)
+        {
+            PrintStats(now - lastStats, &lastRequests);
+            lastStats = now;
+        }
+    }
+
+    for (int i = 0; i < workerCount; i++)
+    {
+        uint64_t one = 1;
+        if (write(workers[i].wakeFd, &one, sizeof(one)) < 0)
+            perror("eventfd");
+        thrd_join(threads[i], NULL);
+    }
+    close(listener);
+    printf("sunucu kapandı\n");
+    return 0;
+}